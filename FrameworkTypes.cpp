@@ -1,34 +1,106 @@
-// Copyright (c) 2016-2017 Josh Blum
+// Copyright (c) 2016-2026 Josh Blum
 // SPDX-License-Identifier: BSL-1.0
 
 #include <Pothos/Plugin.hpp>
 #include <Pothos/Proxy.hpp>
 #include <Pothos/Framework/BufferChunk.hpp>
+#include "PythonProxy.hpp"
 #include <complex>
 #include <cstdint>
+#include <string>
+#include <vector>
 
 /***********************************************************************
  * buffer chunk to/from numpy
+ * numpy arrays and array.array are both read with the buffer protocol
  **********************************************************************/
 static Pothos::Proxy convertBufferChunkToNumpyArray(Pothos::ProxyEnvironment::Sptr env, const Pothos::BufferChunk &buffer)
 {
-    auto module = env->findProxy("Pothos.Buffer");
-    auto dtype = module.get("dtype_to_numpy")(buffer.dtype);
-    return module.get("pointer_to_ndarray")(buffer.address, buffer.elements(), dtype);
+    //the PothosModule exports the chunk through the python buffer protocol,
+    //importing it registers the exporter when no python code has done so yet
+    const Pothos::PluginPath exporterPath("/proxy_helpers/python/buffer_chunk_to_numpy_array");
+    if (not Pothos::PluginRegistry::exists(exporterPath)) env->findProxy("Pothos.PothosModule");
+    const auto exporter = Pothos::PluginRegistry::get(exporterPath).getObject().extract<Pothos::Callable>();
+    return exporter.call<Pothos::Proxy>(env, buffer);
 }
 
-static Pothos::BufferChunk convertNumpyArrayToBufferChunk(const Pothos::Proxy &npArray)
+static std::string bufferFormatToDTypeName(const Py_buffer &view)
 {
+    const char *format = (view.format == nullptr)? "B" : view.format;
+
+    //native or standard byte order prefixes, the data must be native endian
+    #if PY_BIG_ENDIAN
+    if (*format == '<') return "";
+    #else
+    if (*format == '>' or *format == '!') return "";
+    #endif
+    if (*format == '@' or *format == '=' or *format == '<' or *format == '>' or *format == '!') format++;
+
+    const bool isComplex = (*format == 'Z');
+    if (isComplex) format++;
+    if (format[0] == '\0' or format[1] != '\0') return "";
+
+    const std::string bits = std::to_string((isComplex? view.itemsize/2 : view.itemsize)*8);
+    switch (*format)
+    {
+    case 'e':
+    case 'f':
+    case 'd': return (isComplex? "complex_float" : "float") + bits;
+    case 'b':
+    case 'h':
+    case 'i':
+    case 'l':
+    case 'q': if (not isComplex) return "int" + bits; break;
+    case '?':
+    case 'B':
+    case 'H':
+    case 'I':
+    case 'L':
+    case 'Q': if (not isComplex) return "uint" + bits; break;
+    }
+    return "";
+}
+
+static void releaseBufferView(Py_buffer *view)
+{
+    PyGilStateLock lock;
+    PyBuffer_Release(view);
+    delete view;
+}
+
+static Pothos::BufferChunk convertPyBufferToBufferChunk(const Pothos::Proxy &proxy)
+{
+    //fetch pointer, format, shape, and strides in one buffer request
+    auto obj = std::dynamic_pointer_cast<PythonProxyHandle>(proxy.getHandle())->obj;
+    auto view = new Py_buffer();
+    if (PyObject_GetBuffer(obj, view, PyBUF_STRIDES | PyBUF_FORMAT) != 0)
+    {
+        delete view;
+        throw Pothos::ProxyEnvironmentConvertError("convertPyBufferToBufferChunk()", getErrorString());
+    }
+    std::shared_ptr<Py_buffer> viewRef(view, &releaseBufferView);
+
     //extract shape and data type information
-    const auto shape = npArray.get<Pothos::ProxyVector>("shape");
-    const size_t numBytes = npArray.get<size_t>("nbytes");
-    const size_t dimension = (shape.size() > 1)? shape.at(1).convert<size_t>() : 1;
-    const auto dtypeName = npArray.get("dtype").get<std::string>("name");
+    const auto dtypeName = bufferFormatToDTypeName(*view);
+    if (dtypeName.empty()) throw Pothos::ProxyEnvironmentConvertError(
+        "convertPyBufferToBufferChunk()", "unsupported buffer format");
+    const size_t elements = (view->ndim > 0)? size_t(view->shape[0]) : 1;
+    size_t dimension = 1;
+    for (int i = 1; i < view->ndim; i++) dimension *= size_t(view->shape[i]);
     const Pothos::DType dtype(dtypeName, dimension);
-    const size_t address = npArray.get("__array_interface__").call("get", "data").call("__getitem__", 0);
 
-    //create a shared buffer that holds the numpy array
-    auto sharedBuff = Pothos::SharedBuffer(address, numBytes, npArray.getHandle());
+    //strided arrays are copied into a new contiguous buffer
+    if (PyBuffer_IsContiguous(view, 'C') == 0)
+    {
+        Pothos::BufferChunk chunk(dtype, elements);
+        PyBuffer_ToContiguous(chunk.as<void *>(), view, view->len, 'C');
+        return chunk;
+    }
+
+    //create a shared buffer that holds the buffer view (and numpy array)
+    const auto address = reinterpret_cast<size_t>(view->buf);
+    const auto numBytes = size_t(view->len);
+    auto sharedBuff = Pothos::SharedBuffer(address, numBytes, viewRef);
 
     //now create a buffer chunk of that shared buffer with matching dtype
     auto chunk = Pothos::BufferChunk(sharedBuff);
@@ -36,6 +108,29 @@ static Pothos::BufferChunk convertNumpyArrayToBufferChunk(const Pothos::Proxy &n
     return chunk;
 }
 
+/***********************************************************************
+ * buffer chunk to numeric vector -- one bulk copy,
+ * buffer conversion handles differing element types
+ **********************************************************************/
+template <typename T>
+static std::vector<T> convertBufferChunkToVector(const Pothos::BufferChunk &chunk)
+{
+    //flatten any dimension into individual elements
+    Pothos::BufferChunk flat(chunk);
+    flat.dtype = Pothos::DType::fromDType(chunk.dtype, 1);
+
+    const Pothos::DType dtype(typeid(T));
+    if (flat.dtype != dtype) flat = flat.convert(dtype);
+    const auto begin = flat.as<const T *>();
+    return std::vector<T>(begin, begin+flat.elements());
+}
+
+static std::vector<char> convertBufferChunkToByteVector(const Pothos::BufferChunk &chunk)
+{
+    const auto begin = chunk.as<const char *>();
+    return std::vector<char>(begin, begin+chunk.length);
+}
+
 template <typename T>
 static T convertNumpyIntegerToNative(const Pothos::Proxy &num)
 {
@@ -59,7 +154,41 @@ pothos_static_block(pothosRegisterNumpyBufferConversions)
     Pothos::PluginRegistry::addCall("/proxy/converters/python/buffer_chunk_to_numpy_array",
         &convertBufferChunkToNumpyArray);
     Pothos::PluginRegistry::add("/proxy/converters/python/numpy_array_to_buffer_chunk",
-        Pothos::ProxyConvertPair("numpy.ndarray", &convertNumpyArrayToBufferChunk));
+        Pothos::ProxyConvertPair("numpy.ndarray", &convertPyBufferToBufferChunk));
+    Pothos::PluginRegistry::add("/proxy/converters/python/array_array_to_buffer_chunk",
+        Pothos::ProxyConvertPair("array.array", &convertPyBufferToBufferChunk));
+
+    //buffer chunk to raw bytes and numeric vector types
+    Pothos::PluginRegistry::addCall("/object/convert/python/buffer_chunk_to_vector_char",
+        &convertBufferChunkToByteVector);
+    Pothos::PluginRegistry::addCall("/object/convert/python/buffer_chunk_to_vector_int8",
+        &convertBufferChunkToVector<signed char>);
+    Pothos::PluginRegistry::addCall("/object/convert/python/buffer_chunk_to_vector_uint8",
+        &convertBufferChunkToVector<unsigned char>);
+    Pothos::PluginRegistry::addCall("/object/convert/python/buffer_chunk_to_vector_int16",
+        &convertBufferChunkToVector<signed short>);
+    Pothos::PluginRegistry::addCall("/object/convert/python/buffer_chunk_to_vector_uint16",
+        &convertBufferChunkToVector<unsigned short>);
+    Pothos::PluginRegistry::addCall("/object/convert/python/buffer_chunk_to_vector_int32",
+        &convertBufferChunkToVector<signed int>);
+    Pothos::PluginRegistry::addCall("/object/convert/python/buffer_chunk_to_vector_uint32",
+        &convertBufferChunkToVector<unsigned int>);
+    Pothos::PluginRegistry::addCall("/object/convert/python/buffer_chunk_to_vector_long",
+        &convertBufferChunkToVector<signed long>);
+    Pothos::PluginRegistry::addCall("/object/convert/python/buffer_chunk_to_vector_ulong",
+        &convertBufferChunkToVector<unsigned long>);
+    Pothos::PluginRegistry::addCall("/object/convert/python/buffer_chunk_to_vector_llong",
+        &convertBufferChunkToVector<signed long long>);
+    Pothos::PluginRegistry::addCall("/object/convert/python/buffer_chunk_to_vector_ullong",
+        &convertBufferChunkToVector<unsigned long long>);
+    Pothos::PluginRegistry::addCall("/object/convert/python/buffer_chunk_to_vector_float",
+        &convertBufferChunkToVector<float>);
+    Pothos::PluginRegistry::addCall("/object/convert/python/buffer_chunk_to_vector_double",
+        &convertBufferChunkToVector<double>);
+    Pothos::PluginRegistry::addCall("/object/convert/python/buffer_chunk_to_vector_complex_float",
+        &convertBufferChunkToVector<std::complex<float>>);
+    Pothos::PluginRegistry::addCall("/object/convert/python/buffer_chunk_to_vector_complex_double",
+        &convertBufferChunkToVector<std::complex<double>>);
 
     //integer types
     Pothos::PluginRegistry::add("/proxy/converters/python/numpy_int8_to_int8",
@@ -1,4 +1,4 @@
-# Copyright (c) 2014-2016 Josh Blum
+# Copyright (c) 2014-2026 Josh Blum
 # SPDX-License-Identifier: BSL-1.0
 
 from . PothosModule import *
@@ -9,9 +9,19 @@ from . BlockRegistry import BlockRegistry
 import weakref
 
 class Block(object):
+    """
+    Base class for blocks implemented in python.
+
+    Subclasses may define workArrays(self, inputs, outputs) in place of work().
+    The inputs and outputs are tuples of ndarrays for the indexed ports.
+    Return (consumed, produced) where each is an int applied to every port
+    or a sequence with one count per port; or return None to consume nothing.
+    """
     def __init__(self):
         self._block = BlockRegistry("/blocks/python_block")
         self._block._setPyBlock(weakref.proxy(self))
+        self._inputPorts = dict()
+        self._outputPorts = dict()
 
     def __getattr__(self, name):
         return lambda *args: self._block.call(name, *args)
@@ -32,7 +42,10 @@ class Block(object):
         return dict([(key, InputPort(ports.at(key))) for key in ports.keys()])
 
     def input(self, name):
-        return InputPort(self._block.input(name))
+        #port wrappers are cached, ports live as long as the block
+        try: return self._inputPorts[name]
+        except KeyError: port = self._inputPorts[name] = InputPort(self._block.input(name))
+        return port
 
     def outputs(self):
         ports = self._block.outputs()
@@ -43,7 +56,21 @@ class Block(object):
         return dict([(key, OutputPort(ports.at(key))) for key in ports.keys()])
 
     def output(self, name):
-        return OutputPort(self._block.output(name))
+        try: return self._outputPorts[name]
+        except KeyError: port = self._outputPorts[name] = OutputPort(self._block.output(name))
+        return port
+
+    @property
+    def minWorkElements(self):
+        """
+        Skip calling work() until every input has this many elements.
+        A flush timeout still calls work() on a smaller tail, 0 disables.
+        """
+        return self._block.getMinWorkElements()
+
+    @minWorkElements.setter
+    def minWorkElements(self, numElements):
+        self._block.setMinWorkElements(numElements)
 
     def activate(self): pass
 
@@ -0,0 +1,195 @@
+// Copyright (c) 2026 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include "PothosModule.hpp"
+#include <Pothos/Framework/BufferChunk.hpp>
+#include <cassert>
+#include <mutex>
+
+static PyTypeObject BufferChunkType = {
+    PyObject_HEAD_INIT(NULL)
+};
+
+static PyBufferProcs BufferChunkBufferProcs = {
+};
+
+static void BufferChunk_dealloc(BufferChunkObject *self)
+{
+    delete self->buffer;
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+static int BufferChunk_init(BufferChunkObject *self, PyObject *, PyObject *)
+{
+    self->buffer = new Pothos::BufferChunk();
+    self->ndim = 1;
+    self->shape[0] = 0;
+    self->strides[0] = 1;
+    self->itemsize = 1;
+    self->format = "B";
+    return 0;
+}
+
+/***********************************************************************
+ * PEP 3118 format characters for the primitive element types
+ **********************************************************************/
+static const char *primitiveFormat(const size_t size, const bool isFloat, const bool isSigned)
+{
+    if (isFloat) switch (size)
+    {
+    case 2: return "e";
+    case 4: return "f";
+    case 8: return "d";
+    default: return nullptr;
+    }
+    if (isSigned) switch (size)
+    {
+    case 1: return "b";
+    case 2: return "h";
+    case 4: return "i";
+    case 8: return "q";
+    default: return nullptr;
+    }
+    switch (size)
+    {
+    case 1: return "B";
+    case 2: return "H";
+    case 4: return "I";
+    case 8: return "Q";
+    default: return nullptr;
+    }
+}
+
+/***********************************************************************
+ * Determine the exported shape and format from the chunk's dtype:
+ * The first dimension is the number of elements, followed by the
+ * dtype's dimension (when > 1). Complex integers have no PEP 3118
+ * format and are exported as an additional dimension of size 2.
+ * Custom types are exported as an additional dimension of bytes.
+ **********************************************************************/
+static void BufferChunk_setupView(BufferChunkObject *self)
+{
+    const auto &dtype = self->buffer->dtype;
+    const size_t elemSize = dtype.elemSize();
+
+    self->ndim = 0;
+    self->shape[self->ndim++] = Py_ssize_t(self->buffer->elements());
+    if (dtype.dimension() > 1) self->shape[self->ndim++] = Py_ssize_t(dtype.dimension());
+
+    const char *format = nullptr;
+    size_t itemsize = elemSize;
+    if (dtype.isCustom()) format = nullptr;
+    else if (dtype.isComplex() and dtype.isFloat())
+    {
+        if (elemSize == 8) format = "Zf";
+        else if (elemSize == 16) format = "Zd";
+    }
+    else if (dtype.isComplex())
+    {
+        itemsize = elemSize/2;
+        format = primitiveFormat(itemsize, false, dtype.isSigned());
+        if (format != nullptr) self->shape[self->ndim++] = 2;
+    }
+    else format = primitiveFormat(elemSize, dtype.isFloat(), dtype.isSigned());
+
+    //fallback to bytes when there is no matching format
+    if (format == nullptr)
+    {
+        format = "B";
+        itemsize = 1;
+        if (elemSize > 1) self->shape[self->ndim++] = Py_ssize_t(elemSize);
+    }
+    self->format = format;
+    self->itemsize = Py_ssize_t(itemsize);
+
+    //C-contiguous strides
+    Py_ssize_t stride = self->itemsize;
+    for (int i = self->ndim-1; i >= 0; i--)
+    {
+        self->strides[i] = stride;
+        stride *= self->shape[i];
+    }
+}
+
+/***********************************************************************
+ * buffer protocol export -- the view holds a reference to self,
+ * which keeps the underlying SharedBuffer alive for the consumer
+ **********************************************************************/
+static int BufferChunk_getbuffer(BufferChunkObject *self, Py_buffer *view, int flags)
+{
+    Py_ssize_t len = self->itemsize;
+    for (int i = 0; i < self->ndim; i++) len *= self->shape[i];
+
+    view->obj = (PyObject *)self;
+    Py_INCREF(self);
+    view->buf = reinterpret_cast<void *>(self->buffer->address);
+    view->len = len;
+    view->readonly = 0;
+    view->itemsize = self->itemsize;
+    view->format = ((flags & PyBUF_FORMAT) == PyBUF_FORMAT)? const_cast<char *>(self->format) : nullptr;
+    view->ndim = self->ndim;
+    view->shape = ((flags & PyBUF_ND) == PyBUF_ND)? self->shape : nullptr;
+    view->strides = ((flags & PyBUF_STRIDES) == PyBUF_STRIDES)? self->strides : nullptr;
+    view->suboffsets = nullptr;
+    view->internal = nullptr;
+    return 0;
+}
+
+PyObject *makeBufferChunkObject(const Pothos::BufferChunk &buffer)
+{
+    PyObject *o = PyObject_CallObject((PyObject *)&BufferChunkType, nullptr);
+    if (o == nullptr) return nullptr;
+    auto bufferObject = reinterpret_cast<BufferChunkObject *>(o);
+    *(bufferObject->buffer) = buffer;
+    BufferChunk_setupView(bufferObject);
+    return o;
+}
+
+PyObject *makeNumpyArrayObject(const Pothos::BufferChunk &buffer)
+{
+    //lookup numpy.asarray once, the module stays loaded
+    static PyStateMutex mutex;
+    static PyObject *asarray = nullptr;
+    std::unique_lock<PyStateMutex> lock(mutex);
+    if (asarray == nullptr)
+    {
+        PyObjectRef numpy(PyImport_ImportModule("numpy"), REF_NEW);
+        if (numpy.obj == nullptr) return nullptr;
+        asarray = PyObject_GetAttrString(numpy.obj, "asarray");
+        if (asarray == nullptr) return nullptr;
+    }
+
+    lock.unlock();
+
+    PyObjectRef chunk(makeBufferChunkObject(buffer), REF_NEW);
+    if (chunk.obj == nullptr) return nullptr;
+    return PyObject_CallFunctionObjArgs(asarray, chunk.obj, nullptr);
+}
+
+bool isBufferChunkObject(PyObject *obj)
+{
+    if (obj == nullptr) return false;
+    return Py_TYPE(obj) == &BufferChunkType;
+}
+
+void registerBufferChunkType(PyObject *m)
+{
+    BufferChunkType.tp_new = PyType_GenericNew;
+    BufferChunkType.tp_name = "PothosBufferChunk";
+    BufferChunkType.tp_basicsize = sizeof(BufferChunkObject);
+    BufferChunkType.tp_dealloc = (destructor)BufferChunk_dealloc;
+    BufferChunkType.tp_flags = Py_TPFLAGS_DEFAULT;
+    #if PY_MAJOR_VERSION < 3
+    BufferChunkType.tp_flags |= Py_TPFLAGS_HAVE_NEWBUFFER;
+    #endif
+    BufferChunkType.tp_doc = "Pothos BufferChunk buffer protocol binding";
+    BufferChunkType.tp_init = (initproc)BufferChunk_init;
+
+    BufferChunkType.tp_as_buffer = &BufferChunkBufferProcs;
+    BufferChunkBufferProcs.bf_getbuffer = (getbufferproc)BufferChunk_getbuffer;
+
+    if (PyType_Ready(&BufferChunkType) < 0) return;
+
+    Py_INCREF(&BufferChunkType);
+    PyModule_AddObject(m, "BufferChunk", (PyObject *)&BufferChunkType);
+}
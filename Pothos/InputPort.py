@@ -1,4 +1,4 @@
-# Copyright (c) 2014-2016 Josh Blum
+# Copyright (c) 2014-2026 Josh Blum
 # SPDX-License-Identifier: BSL-1.0
 
 from . PothosModule import *
@@ -7,9 +7,14 @@ from . Buffer import pointer_to_ndarray
 from . Buffer import dtype_to_numpy
 import numpy
 
-class InputPort(object):
+class InputPort(InputPortBase):
+    """
+    The hot methods (elements, totalElements, consume, buffer,
+    hasMessage, popMessage) are implemented by InputPortBase,
+    everything else is forwarded through the port's proxy.
+    """
     def __init__(self, port):
-        self._port = port
+        InputPortBase.__init__(self, port)
 
     def __getattr__(self, name):
         return lambda *args: self._port.call(name, *args)
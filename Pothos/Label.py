@@ -1,7 +1,8 @@
-# Copyright (c) 2014-2016 Josh Blum
+# Copyright (c) 2014-2026 Josh Blum
 # SPDX-License-Identifier: BSL-1.0
 
 from . PothosModule import *
+import numpy
 
 Label = ProxyEnvironment("managed").findProxy('Pothos/Label')
 
@@ -13,6 +14,19 @@ class LabelIteratorRange(object):
         return lambda *args: self._labelIter.call(name, *args)
 
     def __iter__(self):
+        labels = labelRangeToList(self._labelIter)
+        if labels is None: return self._iterProxy()
+        return iter(labels)
+
+    def indexes(self):
+        """
+        The label indexes as an int64 numpy array for vectorized filtering.
+        """
+        indexes = labelRangeIndexes(self._labelIter)
+        if indexes is None: indexes = numpy.array([l.index for l in self._iterProxy()], numpy.int64)
+        return indexes
+
+    def _iterProxy(self):
         index = 0
         while True:
             i = self._labelIter.at(index)
@@ -0,0 +1,78 @@
+// Copyright (c) 2026 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include "PothosModule.hpp"
+#include <Pothos/Framework/Label.hpp>
+#include <Pothos/Framework/BufferChunk.hpp>
+#include <Pothos/Framework/DType.hpp>
+#include <cstdint>
+
+/***********************************************************************
+ * Bulk conversions for a Pothos::LabelIteratorRange proxy,
+ * one call replaces the at(), end() and deref() calls per label.
+ * Ranges that are not local return None without an exception,
+ * the caller falls back to iterating through the proxy.
+ **********************************************************************/
+static bool extractLabelRange(PyObject *arg, Pothos::LabelIteratorRange &range)
+{
+    try
+    {
+        const auto obj = PyObjectToProxy(arg).toObject();
+        if (obj.type() != typeid(Pothos::LabelIteratorRange)) return false;
+        range = obj.extract<Pothos::LabelIteratorRange>();
+        return true;
+    }
+    catch (const Pothos::Exception &)
+    {
+        return false;
+    }
+}
+
+static PyObject *labelRangeToList(PyObject *, PyObject *arg)
+{
+    Pothos::LabelIteratorRange range;
+    if (not extractLabelRange(arg, range)) Py_RETURN_NONE;
+
+    PyObjectRef list(PyList_New(range.end()-range.begin()), REF_NEW);
+    if (list.obj == nullptr) return nullptr;
+    try
+    {
+        const auto env = getPythonProxyEnv();
+        Py_ssize_t i = 0;
+        for (const auto &label : range)
+        {
+            PyList_SET_ITEM(list.obj, i++, ProxyToPyObject(env->convertObjectToProxy(Pothos::Object(label))));
+        }
+    }
+    catch (const Pothos::Exception &ex)
+    {
+        PyErr_SetString(PyExc_RuntimeError, ex.displayText().c_str());
+        return nullptr;
+    }
+    return list.newRef();
+}
+
+static PyObject *labelRangeIndexes(PyObject *, PyObject *arg)
+{
+    Pothos::LabelIteratorRange range;
+    if (not extractLabelRange(arg, range)) Py_RETURN_NONE;
+
+    Pothos::BufferChunk indexes(Pothos::DType(typeid(int64_t)), range.end()-range.begin());
+    auto out = indexes.as<int64_t *>();
+    for (const auto &label : range) *(out++) = int64_t(label.index);
+    return makeNumpyArrayObject(indexes);
+}
+
+static PyMethodDef LabelUtils_methods[] = {
+    {"labelRangeToList", (PyCFunction)labelRangeToList, METH_O, "Convert a LabelIteratorRange into a list of labels, None when not local"},
+    {"labelRangeIndexes", (PyCFunction)labelRangeIndexes, METH_O, "The label indexes of a LabelIteratorRange as an int64 numpy array, None when not local"},
+    {NULL}  /* Sentinel */
+};
+
+void registerLabelUtils(PyObject *m)
+{
+    for (auto def = LabelUtils_methods; def->ml_name != nullptr; def++)
+    {
+        PyModule_AddObject(m, def->ml_name, PyCFunction_New(def, nullptr));
+    }
+}
@@ -1,4 +1,4 @@
-# Copyright (c) 2014-2016 Josh Blum
+# Copyright (c) 2014-2026 Josh Blum
 # SPDX-License-Identifier: BSL-1.0
 
 from . PothosModule import *
@@ -8,9 +8,14 @@ from . Label import Label
 from . Packet import Packet
 import numpy
 
-class OutputPort(object):
+class OutputPort(OutputPortBase):
+    """
+    The hot methods (elements, totalElements, produce, buffer,
+    postMessage, postLabel, postBuffer) are implemented by OutputPortBase,
+    everything else is forwarded through the port's proxy.
+    """
     def __init__(self, port):
-        self._port = port
+        OutputPortBase.__init__(self, port)
         self._env = self._port.getEnvironment()
 
     def __getattr__(self, name):
@@ -0,0 +1,282 @@
+// Copyright (c) 2026 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include "PothosModule.hpp"
+#include <Pothos/Framework.hpp>
+#include <cassert>
+
+static PyTypeObject InputPortType = {
+    PyObject_HEAD_INIT(NULL)
+};
+
+static PyTypeObject OutputPortType = {
+    PyObject_HEAD_INIT(NULL)
+};
+
+/***********************************************************************
+ * Common port implementation: the port pointer is extracted once,
+ * ports from environments that cannot provide one fall back to calls
+ * through the proxy so the same python code works for every port.
+ **********************************************************************/
+static void Port_dealloc(PortObject *self)
+{
+    Py_XDECREF(self->port);
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+static int Port_init(PortObject *self, PyObject *args, PyObject *)
+{
+    PyObject *port = nullptr;
+    if (not PyArg_ParseTuple(args, "O", &port)) return -1;
+    if (not isProxyInstance(port))
+    {
+        PyErr_SetString(PyExc_TypeError, "expects a PothosProxy for the port");
+        return -1;
+    }
+
+    Py_INCREF(port);
+    Py_XDECREF(self->port);
+    self->port = port;
+    self->input = nullptr;
+    self->output = nullptr;
+
+    try
+    {
+        const auto obj = reinterpret_cast<ProxyObject *>(port)->proxy->toObject();
+        if (obj.type() == typeid(Pothos::InputPort *)) self->input = obj.extract<Pothos::InputPort *>();
+        if (obj.type() == typeid(Pothos::OutputPort *)) self->output = obj.extract<Pothos::OutputPort *>();
+    }
+    catch (const Pothos::Exception &)
+    {
+        //not a local port, use the proxy
+    }
+
+    return 0;
+}
+
+static PyObject *Port_getPort(PortObject *self, void *)
+{
+    Py_INCREF(self->port);
+    return self->port;
+}
+
+//! Call through the port's proxy when there is no port pointer
+static PyObject *Port_callProxy(PortObject *self, const char *name, PyObject *arg = nullptr)
+{
+    const auto &proxy = *reinterpret_cast<ProxyObject *>(self->port)->proxy;
+    const auto result = callProxyWithPyArgs(proxy, name, &arg, (arg == nullptr)? 0 : 1);
+    return ProxyToPyObject(proxyEnvTranslate(result, getPythonProxyEnv()));
+}
+
+//! Translate framework exceptions into python errors
+template <typename Fcn>
+static PyObject *Port_guard(const Fcn &fcn)
+{
+    try
+    {
+        return fcn();
+    }
+    catch (const Pothos::Exception &ex)
+    {
+        PyErr_SetString(PyExc_RuntimeError, ex.displayText().c_str());
+        return nullptr;
+    }
+}
+
+static bool Port_parseCount(PyObject *arg, size_t &count)
+{
+    const auto value = PyNumber_AsSsize_t(arg, PyExc_OverflowError);
+    if (value == -1 and PyErr_Occurred()) return false;
+    if (value < 0)
+    {
+        PyErr_SetString(PyExc_ValueError, "count must not be negative");
+        return false;
+    }
+    count = size_t(value);
+    return true;
+}
+
+/***********************************************************************
+ * Pothos::InputPort methods
+ **********************************************************************/
+static PyObject *InputPort_elements(PortObject *self, PyObject *)
+{
+    return Port_guard([self]
+    {
+        if (self->input == nullptr) return Port_callProxy(self, "elements");
+        return PyLong_FromSize_t(self->input->elements());
+    });
+}
+
+static PyObject *InputPort_totalElements(PortObject *self, PyObject *)
+{
+    return Port_guard([self]
+    {
+        if (self->input == nullptr) return Port_callProxy(self, "totalElements");
+        return PyLong_FromUnsignedLongLong(self->input->totalElements());
+    });
+}
+
+static PyObject *InputPort_consume(PortObject *self, PyObject *arg)
+{
+    return Port_guard([self, arg]() -> PyObject *
+    {
+        if (self->input == nullptr) return Port_callProxy(self, "consume", arg);
+        size_t count = 0;
+        if (not Port_parseCount(arg, count)) return nullptr;
+        self->input->consume(count);
+        Py_RETURN_NONE;
+    });
+}
+
+static PyObject *InputPort_buffer(PortObject *self, PyObject *)
+{
+    return Port_guard([self]
+    {
+        if (self->input == nullptr) return Port_callProxy(self, "buffer");
+        return makeNumpyArrayObject(self->input->buffer());
+    });
+}
+
+static PyObject *InputPort_hasMessage(PortObject *self, PyObject *)
+{
+    return Port_guard([self]
+    {
+        if (self->input == nullptr) return Port_callProxy(self, "hasMessage");
+        return PyBool_FromLong(self->input->hasMessage());
+    });
+}
+
+static PyObject *InputPort_popMessage(PortObject *self, PyObject *)
+{
+    return Port_guard([self]
+    {
+        if (self->input == nullptr) return Port_callProxy(self, "popMessage");
+        return ProxyToPyObject(getPythonProxyEnv()->convertObjectToProxy(self->input->popMessage()));
+    });
+}
+
+static PyMethodDef InputPort_methods[] = {
+    {"elements", (PyCFunction)InputPort_elements, METH_NOARGS, "Pothos::InputPort::elements()"},
+    {"totalElements", (PyCFunction)InputPort_totalElements, METH_NOARGS, "Pothos::InputPort::totalElements()"},
+    {"consume", (PyCFunction)InputPort_consume, METH_O, "Pothos::InputPort::consume(numElements)"},
+    {"buffer", (PyCFunction)InputPort_buffer, METH_NOARGS, "Pothos::InputPort::buffer() as a numpy array"},
+    {"hasMessage", (PyCFunction)InputPort_hasMessage, METH_NOARGS, "Pothos::InputPort::hasMessage()"},
+    {"popMessage", (PyCFunction)InputPort_popMessage, METH_NOARGS, "Pothos::InputPort::popMessage()"},
+    {NULL}  /* Sentinel */
+};
+
+/***********************************************************************
+ * Pothos::OutputPort methods
+ **********************************************************************/
+static PyObject *OutputPort_elements(PortObject *self, PyObject *)
+{
+    return Port_guard([self]
+    {
+        if (self->output == nullptr) return Port_callProxy(self, "elements");
+        return PyLong_FromSize_t(self->output->elements());
+    });
+}
+
+static PyObject *OutputPort_totalElements(PortObject *self, PyObject *)
+{
+    return Port_guard([self]
+    {
+        if (self->output == nullptr) return Port_callProxy(self, "totalElements");
+        return PyLong_FromUnsignedLongLong(self->output->totalElements());
+    });
+}
+
+static PyObject *OutputPort_produce(PortObject *self, PyObject *arg)
+{
+    return Port_guard([self, arg]() -> PyObject *
+    {
+        if (self->output == nullptr) return Port_callProxy(self, "produce", arg);
+        size_t count = 0;
+        if (not Port_parseCount(arg, count)) return nullptr;
+        self->output->produce(count);
+        Py_RETURN_NONE;
+    });
+}
+
+static PyObject *OutputPort_buffer(PortObject *self, PyObject *)
+{
+    return Port_guard([self]
+    {
+        if (self->output == nullptr) return Port_callProxy(self, "buffer");
+        return makeNumpyArrayObject(self->output->buffer());
+    });
+}
+
+static PyObject *OutputPort_postMessage(PortObject *self, PyObject *arg)
+{
+    return Port_guard([self, arg]() -> PyObject *
+    {
+        if (self->output == nullptr) return Port_callProxy(self, "postMessage", arg);
+        self->output->postMessage(PyObjectToProxy(arg).toObject());
+        Py_RETURN_NONE;
+    });
+}
+
+static PyObject *OutputPort_postLabel(PortObject *self, PyObject *arg)
+{
+    return Port_guard([self, arg]() -> PyObject *
+    {
+        if (self->output == nullptr) return Port_callProxy(self, "postLabel", arg);
+        self->output->postLabel(PyObjectToProxy(arg).convert<Pothos::Label>());
+        Py_RETURN_NONE;
+    });
+}
+
+static PyObject *OutputPort_postBuffer(PortObject *self, PyObject *arg)
+{
+    return Port_guard([self, arg]() -> PyObject *
+    {
+        if (self->output == nullptr) return Port_callProxy(self, "postBuffer", arg);
+        self->output->postBuffer(PyObjectToProxy(arg).convert<Pothos::BufferChunk>());
+        Py_RETURN_NONE;
+    });
+}
+
+static PyMethodDef OutputPort_methods[] = {
+    {"elements", (PyCFunction)OutputPort_elements, METH_NOARGS, "Pothos::OutputPort::elements()"},
+    {"totalElements", (PyCFunction)OutputPort_totalElements, METH_NOARGS, "Pothos::OutputPort::totalElements()"},
+    {"produce", (PyCFunction)OutputPort_produce, METH_O, "Pothos::OutputPort::produce(numElements)"},
+    {"buffer", (PyCFunction)OutputPort_buffer, METH_NOARGS, "Pothos::OutputPort::buffer() as a numpy array"},
+    {"postMessage", (PyCFunction)OutputPort_postMessage, METH_O, "Pothos::OutputPort::postMessage(message)"},
+    {"postLabel", (PyCFunction)OutputPort_postLabel, METH_O, "Pothos::OutputPort::postLabel(label)"},
+    {"postBuffer", (PyCFunction)OutputPort_postBuffer, METH_O, "Pothos::OutputPort::postBuffer(buffer)"},
+    {NULL}  /* Sentinel */
+};
+
+static PyGetSetDef Port_getset[] = {
+    {(char *)"_port", (getter)Port_getPort, nullptr, (char *)"the PothosProxy for the port", nullptr},
+    {NULL}  /* Sentinel */
+};
+
+/***********************************************************************
+ * type registration
+ **********************************************************************/
+static void registerPortType(PyObject *m, PyTypeObject &type, const char *name, const char *attrName, const char *doc, PyMethodDef *methods)
+{
+    type.tp_new = PyType_GenericNew;
+    type.tp_name = name;
+    type.tp_basicsize = sizeof(PortObject);
+    type.tp_dealloc = (destructor)Port_dealloc;
+    type.tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE;
+    type.tp_doc = doc;
+    type.tp_methods = methods;
+    type.tp_getset = Port_getset;
+    type.tp_init = (initproc)Port_init;
+
+    if (PyType_Ready(&type) < 0) return;
+
+    Py_INCREF(&type);
+    PyModule_AddObject(m, attrName, (PyObject *)&type);
+}
+
+void registerPortTypes(PyObject *m)
+{
+    registerPortType(m, InputPortType, "PothosInputPort", "InputPortBase", "Pothos InputPort binding", InputPort_methods);
+    registerPortType(m, OutputPortType, "PothosOutputPort", "OutputPortBase", "Pothos OutputPort binding", OutputPort_methods);
+}
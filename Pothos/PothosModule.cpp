@@ -1,9 +1,10 @@
-// Copyright (c) 2014-2016 Josh Blum
+// Copyright (c) 2014-2026 Josh Blum
 // SPDX-License-Identifier: BSL-1.0
 
 #include "PothosModule.hpp"
 #include <Pothos/Plugin.hpp>
 #include <Pothos/Init.hpp>
+#include <Pothos/Framework/BufferChunk.hpp>
 #include <iostream>
 #include <cassert>
 #include <cstdlib>
@@ -12,6 +13,7 @@
  * module utility converters
  **********************************************************************/
 static Pothos::ProxyEnvironment::Sptr myPythonProxyEnv;
+static Pothos::ProxyEnvironment::Sptr myPythonArrayProxyEnv;
 static PyObjectToProxyFcn myPyObjectToProxyFcn;
 static ProxyToPyObjectFcn myProxyToPyObjectFcn;
 
@@ -22,6 +24,10 @@ static void initPyObjectUtilityConverters(void)
         Pothos::init(); //init here in case python is the caller
         std::atexit(&Pothos::deinit);
         myPythonProxyEnv = Pothos::ProxyEnvironment::make("python");
+        Pothos::ProxyEnvironmentArgs arrayArgs;
+        arrayArgs["numeric_vectors"] = "ndarray";
+        arrayArgs["byte_vectors"] = "memoryview";
+        myPythonArrayProxyEnv = Pothos::ProxyEnvironment::make("python", arrayArgs);
         myPyObjectToProxyFcn = Pothos::PluginRegistry::get("/proxy_helpers/python/pyobject_to_proxy").getObject().extract<PyObjectToProxyFcn>();
         myProxyToPyObjectFcn = Pothos::PluginRegistry::get("/proxy_helpers/python/proxy_to_pyobject").getObject().extract<ProxyToPyObjectFcn>();
         registerPothosModuleConverters();
@@ -37,29 +43,35 @@ static void handlePythonPluginEvent(const Pothos::Plugin &plugin, const std::str
     if (event == "remove" and plugin.getPath() == Pothos::PluginPath("/proxy_helpers/python/pyobject_to_proxy"))
     {
         myPythonProxyEnv.reset();
+        myPythonArrayProxyEnv.reset();
         myPyObjectToProxyFcn = PyObjectToProxyFcn();
         Pothos::PluginRegistry::remove("/proxy/converters/python/proxy_to_pyproxy");
+        Pothos::PluginRegistry::remove("/proxy_helpers/python/buffer_chunk_to_numpy_array");
     }
     if (event == "remove" and plugin.getPath() == Pothos::PluginPath("/proxy_helpers/python/proxy_to_pyobject"))
     {
         myPythonProxyEnv.reset();
+        myPythonArrayProxyEnv.reset();
         myProxyToPyObjectFcn = ProxyToPyObjectFcn();
         Pothos::PluginRegistry::remove("/proxy/converters/python/pyproxy_to_proxy");
     }
 }
 
+/***********************************************************************
+ * The caller holds the GIL: the helpers only wrap or unwrap references,
+ * so the GIL is kept rather than handed off and taken back again.
+ * The GIL is released only around potentially blocking proxy calls.
+ **********************************************************************/
 Pothos::Proxy PyObjectToProxy(PyObject *obj)
 {
     assert(obj != nullptr);
     if (isProxyObject(obj)) return *reinterpret_cast<ProxyObject *>(obj)->proxy;
-    PyThreadStateLock lock;
     return myPyObjectToProxyFcn(myPythonProxyEnv, obj);
 }
 
 PyObject *ProxyToPyObject(const Pothos::Proxy &proxy)
 {
     assert(proxy);
-    PyThreadStateLock lock;
     return myProxyToPyObjectFcn(proxy);
 }
 
@@ -68,6 +80,11 @@ Pothos::ProxyEnvironment::Sptr getPythonProxyEnv(void)
     return myPythonProxyEnv;
 }
 
+Pothos::ProxyEnvironment::Sptr getPythonArrayProxyEnv(void)
+{
+    return myPythonArrayProxyEnv;
+}
+
 /***********************************************************************
  * converters to and from pothos proxy type
  **********************************************************************/
@@ -80,7 +97,21 @@ static Pothos::Proxy convertPyProxyToProxy(const Pothos::Proxy &proxy)
 static Pothos::Proxy convertProxyToPyProxy(Pothos::ProxyEnvironment::Sptr env, const Pothos::Proxy &proxy)
 {
     PyObjectRef ref(makeProxyObject(proxy), REF_NEW);
-    PyThreadStateLock lock;
+    return myPyObjectToProxyFcn(env, ref.obj);
+}
+
+/***********************************************************************
+ * buffer chunk to numpy array through the buffer protocol exporter,
+ * called by the converter that FrameworkTypes registers with the plugin
+ **********************************************************************/
+static Pothos::Proxy convertBufferChunkToNumpyArray(Pothos::ProxyEnvironment::Sptr env, const Pothos::BufferChunk &buffer)
+{
+    PyObjectRef ref(makeNumpyArrayObject(buffer), REF_NEW);
+    if (ref.obj == nullptr)
+    {
+        PyErr_Clear();
+        throw Pothos::ProxyEnvironmentConvertError("convertBufferChunkToNumpyArray()", "failed to create numpy array");
+    }
     return myPyObjectToProxyFcn(env, ref.obj);
 }
 
@@ -91,6 +122,8 @@ void registerPothosModuleConverters(void)
         &convertProxyToPyProxy);
     Pothos::PluginRegistry::add("/proxy/converters/python/pyproxy_to_proxy",
         Pothos::ProxyConvertPair("PothosProxy", &convertPyProxyToProxy));
+    Pothos::PluginRegistry::addCall("/proxy_helpers/python/buffer_chunk_to_numpy_array",
+        &convertBufferChunkToNumpyArray);
 }
 
 /***********************************************************************
@@ -119,6 +152,10 @@ void initPothosModule(void)
         nullptr, nullptr, nullptr, nullptr, nullptr
     };
     PyObject *m = PyModule_Create(&PothosModule);
+    #ifdef Py_GIL_DISABLED
+    //module state is set once at import, conversions do not rely on the GIL
+    if (m != nullptr) PyUnstable_Module_SetGIL(m, Py_MOD_GIL_NOT_USED);
+    #endif
     #else
     PyObject *m = Py_InitModule("PothosModule", nullptr);
     #endif
@@ -132,6 +169,9 @@ void initPothosModule(void)
         registerProxyType(m);
         registerProxyCallType(m);
         registerProxyEnvironmentType(m);
+        registerBufferChunkType(m);
+        registerPortTypes(m);
+        registerLabelUtils(m);
     }
 
     #if PY_MAJOR_VERSION >= 3
@@ -1,18 +1,21 @@
-// Copyright (c) 2014-2016 Josh Blum
+// Copyright (c) 2014-2026 Josh Blum
 // SPDX-License-Identifier: BSL-1.0
 
 #include "../PyObjectUtils.hpp"
 #include <Pothos/Proxy.hpp>
 
-//! Module utility to convert between forms
+//! Module utility to convert between forms (the caller holds the GIL)
 Pothos::Proxy PyObjectToProxy(PyObject *obj);
 
-//! Module utility to convert between forms
+//! Module utility to convert between forms (the caller holds the GIL)
 PyObject *ProxyToPyObject(const Pothos::Proxy &proxy);
 
 //! Access the proxy environment for python
 Pothos::ProxyEnvironment::Sptr getPythonProxyEnv(void);
 
+//! Access the proxy environment for python that converts vectors without per-element objects
+Pothos::ProxyEnvironment::Sptr getPythonArrayProxyEnv(void);
+
 //! Convert a proxy from one env into another
 inline Pothos::Proxy proxyEnvTranslate(const Pothos::Proxy &proxy, const Pothos::ProxyEnvironment::Sptr &env)
 {
@@ -47,6 +50,10 @@ struct ProxyObject
 {
     PyObject_HEAD
     Pothos::Proxy *proxy;
+    PyObject *calls; //!< bound ProxyCall cache by attribute name (or null)
+    #ifdef POTHOS_PY_VECTORCALL
+    vectorcallfunc vectorcall;
+    #endif
 };
 
 //! called by module to register type
@@ -58,14 +65,23 @@ PyObject *makeProxyObject(const Pothos::Proxy &proxy);
 //! utility for c api to check if a proxy
 bool isProxyObject(PyObject *obj);
 
+//! utility for c api to check if a proxy or an instance of a subclass
+bool isProxyInstance(PyObject *obj);
+
+//! utility for c api to call on a proxy with an array of python arguments
+Pothos::Proxy callProxyWithPyArgs(const Pothos::Proxy &proxy, const std::string &name, PyObject *const *args, const size_t numArgs);
+
 /***********************************************************************
  * Pothos::ProxyCall support
  **********************************************************************/
 struct ProxyCallObject
 {
     PyObject_HEAD
-    PyObjectRef *proxy;
-    PyObjectRef *name;
+    Pothos::Proxy *proxy; //!< a copy of the handle, no reference to the PothosProxy
+    std::string *name; //!< converted once when the call is created
+    #ifdef POTHOS_PY_VECTORCALL
+    vectorcallfunc vectorcall;
+    #endif
 };
 
 //! called by module to register type
@@ -74,6 +90,57 @@ void registerProxyCallType(PyObject *m);
 //! utility for c api to construct a proxy call object
 PyObject *makeProxyCallObject(PyObject *args);
 
+/***********************************************************************
+ * Pothos::BufferChunk support
+ **********************************************************************/
+namespace Pothos { class BufferChunk; }
+
+struct BufferChunkObject
+{
+    PyObject_HEAD
+    Pothos::BufferChunk *buffer;
+    const char *format;
+    Py_ssize_t itemsize;
+    int ndim;
+    Py_ssize_t shape[3];
+    Py_ssize_t strides[3];
+};
+
+//! called by module to register type
+void registerBufferChunkType(PyObject *m);
+
+//! utility for c api to construct a buffer protocol exporter
+PyObject *makeBufferChunkObject(const Pothos::BufferChunk &buffer);
+
+//! utility for c api to construct a numpy array view of a buffer
+PyObject *makeNumpyArrayObject(const Pothos::BufferChunk &buffer);
+
+//! utility for c api to check if a buffer chunk
+bool isBufferChunkObject(PyObject *obj);
+
+/***********************************************************************
+ * Pothos::InputPort and Pothos::OutputPort support
+ **********************************************************************/
+namespace Pothos { class InputPort; class OutputPort; }
+
+struct PortObject
+{
+    PyObject_HEAD
+    PyObject *port; //!< the PothosProxy for the port
+    Pothos::InputPort *input; //!< null when not a local input port
+    Pothos::OutputPort *output; //!< null when not a local output port
+};
+
+//! called by module to register the InputPortBase and OutputPortBase types
+void registerPortTypes(PyObject *m);
+
+/***********************************************************************
+ * Pothos::LabelIteratorRange support
+ **********************************************************************/
+
+//! called by module to register labelRangeToList and labelRangeIndexes
+void registerLabelUtils(PyObject *m);
+
 /***********************************************************************
  * rich compare support for old-style cmp
  **********************************************************************/
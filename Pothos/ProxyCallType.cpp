@@ -1,8 +1,9 @@
-// Copyright (c) 2014 Josh Blum
+// Copyright (c) 2014-2026 Josh Blum
 // SPDX-License-Identifier: BSL-1.0
 
 #include "PothosModule.hpp"
 #include <cassert>
+#include <cstddef>
 
 static PyTypeObject ProxyCallType = {
     PyObject_HEAD_INIT(NULL)
@@ -15,37 +16,47 @@ static void ProxyCall_dealloc(ProxyCallObject *self)
     Py_TYPE(self)->tp_free((PyObject*)self);
 }
 
+#ifdef POTHOS_PY_VECTORCALL
+static PyObject *ProxyCall_vectorcall(ProxyCallObject *self, PyObject *const *args, size_t nargsf, PyObject *);
+#endif
+
 static int ProxyCall_init(ProxyCallObject *self, PyObject *args, PyObject *)
 {
-    self->proxy = new PyObjectRef(PyTuple_GetItem(args, 0), REF_BORROWED);
-    self->name = new PyObjectRef(PyTuple_GetItem(args, 1), REF_BORROWED);
+    self->proxy = new Pothos::Proxy();
+    self->name = new std::string();
+    #ifdef POTHOS_PY_VECTORCALL
+    self->vectorcall = (vectorcallfunc)ProxyCall_vectorcall;
+    #endif
+
+    //check the input
+    if (args == nullptr or PyTuple_Size(args) != 2 or not isProxyInstance(PyTuple_GET_ITEM(args, 0)))
+    {
+        PyErr_SetString(PyExc_RuntimeError, "ProxyCall __init__ takes a proxy and a name");
+        return -1;
+    }
+
+    try
+    {
+        *(self->proxy) = *reinterpret_cast<ProxyObject *>(PyTuple_GET_ITEM(args, 0))->proxy;
+        *(self->name) = PyObjectToProxy(PyTuple_GET_ITEM(args, 1)).convert<std::string>();
+    }
+    catch (const Pothos::Exception &ex)
+    {
+        PyErr_SetString(PyExc_RuntimeError, ex.displayText().c_str());
+        return -1;
+    }
     return 0;
 }
 
-PyObject* ProxyCall_call(ProxyCallObject *self, PyObject *args, PyObject *)
+static PyObject *ProxyCall_callHelper(ProxyCallObject *self, PyObject *const *args, const size_t numArgs)
 {
     try
     {
-        //extract string name
-        const auto name = PyObjectToProxy(self->name->obj).convert<std::string>();
-
-        //create call args
-        Pothos::ProxyVector proxyArgs;
-        for (int i = 0; i < PyTuple_Size(args); i++)
-        {
-            proxyArgs.push_back(PyObjectToProxy(PyTuple_GetItem(args, i)));
-        }
-
         //make proxy call
-        auto handle = ((ProxyObject *)self->proxy->obj)->proxy->getHandle();
-        Pothos::Proxy proxy;
-        {
-            PyThreadStateLock lock; //proxy call could be potentially blocking
-            proxy = handle->call(name, proxyArgs.data(), proxyArgs.size());
-        }
+        const auto result = callProxyWithPyArgs(*self->proxy, *self->name, args, numArgs);
 
         //convert the result into a pyobject
-        return ProxyToPyObject(proxyEnvTranslate(proxy, getPythonProxyEnv()));
+        return ProxyToPyObject(proxyEnvTranslate(result, getPythonProxyEnv()));
     }
     catch (const Pothos::Exception &ex)
     {
@@ -54,6 +65,20 @@ PyObject* ProxyCall_call(ProxyCallObject *self, PyObject *args, PyObject *)
     }
 }
 
+PyObject* ProxyCall_call(ProxyCallObject *self, PyObject *args, PyObject *)
+{
+    const Py_ssize_t numArgs = PyTuple_Size(args);
+    if (numArgs == 0) return ProxyCall_callHelper(self, nullptr, 0);
+    return ProxyCall_callHelper(self, &PyTuple_GET_ITEM(args, 0), size_t(numArgs));
+}
+
+#ifdef POTHOS_PY_VECTORCALL
+static PyObject *ProxyCall_vectorcall(ProxyCallObject *self, PyObject *const *args, size_t nargsf, PyObject *)
+{
+    return ProxyCall_callHelper(self, args, PyVectorcall_NARGS(nargsf));
+}
+#endif
+
 PyObject *makeProxyCallObject(PyObject *args)
 {
     return PyObject_CallObject((PyObject *)&ProxyCallType, args);
@@ -69,6 +94,10 @@ void registerProxyCallType(PyObject *m)
     ProxyCallType.tp_doc = "Pothos Proxy Call binding";
     ProxyCallType.tp_init = (initproc)ProxyCall_init;
     ProxyCallType.tp_call = (ternaryfunc)ProxyCall_call;
+    #ifdef POTHOS_PY_VECTORCALL
+    ProxyCallType.tp_vectorcall_offset = offsetof(ProxyCallObject, vectorcall);
+    ProxyCallType.tp_flags |= Py_TPFLAGS_HAVE_VECTORCALL;
+    #endif
 
     if (PyType_Ready(&ProxyCallType) < 0) return;
 
@@ -1,9 +1,15 @@
-// Copyright (c) 2014-2016 Josh Blum
+// Copyright (c) 2014-2026 Josh Blum
 //                    2020 Nicholas Corgan
 // SPDX-License-Identifier: BSL-1.0
 
 #include "PothosModule.hpp"
+#include <Pothos/Plugin.hpp>
+#include <atomic>
 #include <cassert>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <unordered_set>
 
 static PyTypeObject ProxyType = {
     PyObject_HEAD_INIT(NULL)
@@ -15,9 +21,14 @@ static PyNumberMethods ProxyNumberMethods = {
 static void Proxy_dealloc(ProxyObject *self)
 {
     delete self->proxy;
+    Py_XDECREF(self->calls);
     Py_TYPE(self)->tp_free((PyObject*)self);
 }
 
+#ifdef POTHOS_PY_VECTORCALL
+static PyObject *Proxy_vectorcall(ProxyObject *self, PyObject *const *args, size_t nargsf, PyObject *);
+#endif
+
 static int Proxy_init(ProxyObject *self, PyObject *args, PyObject *)
 {
     //check the input
@@ -29,6 +40,10 @@ static int Proxy_init(ProxyObject *self, PyObject *args, PyObject *)
 
     //allocate the proxy container
     self->proxy = new Pothos::Proxy();
+    self->calls = nullptr;
+    #ifdef POTHOS_PY_VECTORCALL
+    self->vectorcall = (vectorcallfunc)Proxy_vectorcall;
+    #endif
 
     //arg0 was specified, make a proxy from py object
     if (args != nullptr and PyTuple_Size(args) > 0)
@@ -39,6 +54,33 @@ static int Proxy_init(ProxyObject *self, PyObject *args, PyObject *)
     return 0;
 }
 
+/***********************************************************************
+ * Negative cache of attributes that are not fields on managed classes:
+ * managed fields are registered per class, so a failed get for a class
+ * fails for every instance. The failed get throws, so skipping it keeps
+ * exceptions out of every method call expression on managed proxies.
+ * Other environments such as python can add attributes per instance.
+ * Any managed class registration event clears the cache on next use.
+ **********************************************************************/
+static PyStateMutex notFieldMutex;
+static std::unordered_set<std::string> notFieldCache;
+static size_t notFieldCacheGeneration(0);
+static std::atomic<size_t> managedGeneration(0);
+
+static void handleManagedPluginEvent(const Pothos::Plugin &, const std::string &)
+{
+    managedGeneration++;
+}
+
+//! The number of bound calls cached per proxy
+static const Py_ssize_t maxCachedCalls = 16;
+
+static std::string notFieldKey(const Pothos::Proxy &proxy, const std::string &name)
+{
+    if (not proxy or proxy.getEnvironment()->getName() != "managed") return "";
+    return proxy.getClassName() + '\n' + name;
+}
+
 static PyObject* Proxy_getattr(PyObject *self, PyObject *attr_name)
 {
     auto callable = PyObject_GenericGetAttr(self, attr_name);
@@ -46,24 +88,74 @@ static PyObject* Proxy_getattr(PyObject *self, PyObject *attr_name)
 
     PyErr_Clear(); //PyObject_GenericGetAttr sets an error when not found
 
+    //repeated lookups of a method return the same bound call
+    auto proxyObject = reinterpret_cast<ProxyObject *>(self);
+    Py_BEGIN_CRITICAL_SECTION(self);
+    if (proxyObject->calls != nullptr)
+    {
+        callable = PyDict_GetItem(proxyObject->calls, attr_name);
+        Py_XINCREF(callable);
+    }
+    Py_END_CRITICAL_SECTION();
+    if (callable != nullptr) return callable;
+    bool cacheCall = false;
+
     try
     {
         //extract string name
         const auto name = PyObjectToProxy(attr_name).convert<std::string>();
+        const auto &selfProxy = *reinterpret_cast<ProxyObject *>(self)->proxy;
+
+        const auto key = notFieldKey(selfProxy, name);
+        const size_t generation = managedGeneration;
+        bool notField = false;
+        if (not key.empty())
+        {
+            std::lock_guard<PyStateMutex> lock(notFieldMutex);
+            if (notFieldCacheGeneration != generation)
+            {
+                notFieldCache.clear();
+                notFieldCacheGeneration = generation;
+            }
+            notField = notFieldCache.count(key) != 0;
+        }
+        cacheCall = notField;
 
         Pothos::Proxy proxy;
+        if (not notField) try
         {
             PyThreadStateLock lock; //proxy call could be potentially blocking
-            proxy = reinterpret_cast<ProxyObject *>(self)->proxy->get(name);
+            proxy = selfProxy.get(name);
+        }
+        catch (const Pothos::Exception &)
+        {
+            if (not key.empty())
+            {
+                std::lock_guard<PyStateMutex> lock(notFieldMutex);
+                if (notFieldCacheGeneration == generation) notFieldCache.insert(key);
+            }
+            cacheCall = not key.empty();
         }
 
         //convert the result into a pyobject
-        return ProxyToPyObject(proxyEnvTranslate(proxy, getPythonProxyEnv()));
+        if (proxy) return ProxyToPyObject(proxyEnvTranslate(proxy, getPythonProxyEnv()));
     }
     catch (const Pothos::Exception &) {}
 
     auto args = PyObjectRef(PyTuple_Pack(2, self, attr_name), REF_NEW);
-    return makeProxyCallObject(args.obj);
+    callable = makeProxyCallObject(args.obj);
+    if (callable == nullptr or not cacheCall) return callable;
+
+    //only methods of managed classes are cached, other environments
+    //can gain a field of the same name; the call holds no ref to self
+    Py_BEGIN_CRITICAL_SECTION(self);
+    if (proxyObject->calls == nullptr and (proxyObject->calls = PyDict_New()) == nullptr) PyErr_Clear();
+    if (proxyObject->calls != nullptr and PyDict_Size(proxyObject->calls) < maxCachedCalls)
+    {
+        if (PyDict_SetItem(proxyObject->calls, attr_name, callable) != 0) PyErr_Clear();
+    }
+    Py_END_CRITICAL_SECTION();
+    return callable;
 }
 
 int Proxy_setattr(PyObject *self, PyObject *attr_name, PyObject *v)
@@ -109,16 +201,46 @@ static PyObject *Proxy_convert(ProxyObject *self, PyObject *)
     }
 }
 
-static Pothos::Proxy Proxy_callProxyHelper(ProxyObject *self, const std::string &name, PyObject *args, const int offset = 0)
+static PyObject *Proxy_convertArray(ProxyObject *self, PyObject *)
 {
-    Pothos::ProxyVector proxyArgs;
-    if (args) for (int i = offset; i < PyTuple_Size(args); i++)
+    try
     {
-        proxyArgs.push_back(PyObjectToProxy(PyTuple_GetItem(args, i)));
+        return ProxyToPyObject(proxyEnvTranslate(*self->proxy, getPythonArrayProxyEnv()));
     }
+    catch (const Pothos::Exception &ex)
+    {
+        PyErr_SetString(PyExc_RuntimeError, ex.displayText().c_str());
+        return nullptr;
+    }
+}
 
+Pothos::Proxy callProxyWithPyArgs(const Pothos::Proxy &proxy, const std::string &name, PyObject *const *args, const size_t numArgs)
+{
+    //convert args into a stack array for the common case of few args
+    static const size_t maxStackArgs = 8;
+    Pothos::Proxy stackArgs[maxStackArgs];
+    Pothos::ProxyVector heapArgs;
+    Pothos::Proxy *proxyArgs = stackArgs;
+    if (numArgs > maxStackArgs)
+    {
+        heapArgs.resize(numArgs);
+        proxyArgs = heapArgs.data();
+    }
+    for (size_t i = 0; i < numArgs; i++)
+    {
+        proxyArgs[i] = PyObjectToProxy(args[i]);
+    }
+
+    auto handle = proxy.getHandle();
     PyThreadStateLock lock; //proxy call could be potentially blocking
-    return self->proxy->getHandle()->call(name, proxyArgs.data(), proxyArgs.size());
+    return handle->call(name, proxyArgs, numArgs);
+}
+
+static Pothos::Proxy Proxy_callProxyHelper(ProxyObject *self, const std::string &name, PyObject *args, const int offset = 0)
+{
+    const Py_ssize_t numArgs = (args == nullptr)? 0 : PyTuple_Size(args)-offset;
+    if (numArgs <= 0) return callProxyWithPyArgs(*self->proxy, name, nullptr, 0);
+    return callProxyWithPyArgs(*self->proxy, name, &PyTuple_GET_ITEM(args, offset), size_t(numArgs));
 }
 
 static Pothos::Proxy Proxy_callProxyHelper(ProxyObject *self, PyObject *args, const int offset = 0)
@@ -176,6 +298,22 @@ static PyObject *Proxy_callFunc(ProxyObject *self, PyObject *args, PyObject *)
     }
 }
 
+#ifdef POTHOS_PY_VECTORCALL
+static PyObject *Proxy_vectorcall(ProxyObject *self, PyObject *const *args, size_t nargsf, PyObject *)
+{
+    try
+    {
+        auto proxy = callProxyWithPyArgs(*self->proxy, "()", args, PyVectorcall_NARGS(nargsf));
+        return ProxyToPyObject(proxyEnvTranslate(proxy, getPythonProxyEnv()));
+    }
+    catch (const Pothos::Exception &ex)
+    {
+        PyErr_SetString(PyExc_RuntimeError, ex.displayText().c_str());
+        return nullptr;
+    }
+}
+#endif
+
 static int Proxy_bool(ProxyObject *self)
 {
     return bool(*self->proxy)? 1 : 0;
@@ -195,6 +333,7 @@ static PyObject *Proxy_getClassName(ProxyObject *self, PyObject *)
 
 static PyMethodDef Proxy_methods[] = {
     {"convert", (PyCFunction)Proxy_convert, METH_NOARGS, "Pothos::Proxy::convert()"},
+    {"convertArray", (PyCFunction)Proxy_convertArray, METH_NOARGS, "Pothos::Proxy::convert() with numeric vectors as numpy arrays and byte vectors as memoryviews"},
     {"callProxy", (PyCFunction)Proxy_callProxy, METH_VARARGS, "Pothos::Proxy::callProxy(name, args...)"},
     {"call", (PyCFunction)Proxy_call, METH_VARARGS, "Pothos::Proxy::call(name, args...)"},
     {"getEnvironment", (PyCFunction)Proxy_getEnvironment, METH_NOARGS, "Pothos::Proxy::getEnvironment()"},
@@ -249,6 +388,12 @@ bool isProxyObject(PyObject *obj)
     return Py_TYPE(obj) == &ProxyType;
 }
 
+bool isProxyInstance(PyObject *obj)
+{
+    if (obj == nullptr) return false;
+    return PyObject_TypeCheck(obj, &ProxyType);
+}
+
 void registerProxyType(PyObject *m)
 {
     ProxyType.tp_new = PyType_GenericNew;
@@ -265,6 +410,10 @@ void registerProxyType(PyObject *m)
     ProxyType.tp_getattro = (getattrofunc)Proxy_getattr;
     ProxyType.tp_setattro = (setattrofunc)Proxy_setattr;
     ProxyType.tp_call = (ternaryfunc)Proxy_callFunc;
+    #ifdef POTHOS_PY_VECTORCALL
+    ProxyType.tp_vectorcall_offset = offsetof(ProxyObject, vectorcall);
+    ProxyType.tp_flags |= Py_TPFLAGS_HAVE_VECTORCALL;
+    #endif
 
     ProxyType.tp_as_number = &ProxyNumberMethods;
     #if PY_MAJOR_VERSION >= 3
@@ -275,6 +424,8 @@ void registerProxyType(PyObject *m)
 
     if (PyType_Ready(&ProxyType) < 0) return;
 
+    Pothos::PluginRegistry::addCall("/managed", &handleManagedPluginEvent);
+
     Py_INCREF(&ProxyType);
     PyModule_AddObject(m, "Proxy", (PyObject *)&ProxyType);
 }
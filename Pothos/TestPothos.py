@@ -1,9 +1,11 @@
-# Copyright (c) 2014-2016 Josh Blum
+# Copyright (c) 2014-2026 Josh Blum
 # SPDX-License-Identifier: BSL-1.0
 
 import Pothos
 import unittest
 import warnings
+import threading
+import time
 import numpy as np
 
 # Pothos can't do this from its Proxy infrastructure because it can't
@@ -55,6 +57,82 @@ class TestPothosModule(unittest.TestCase):
         self.assertLess(oneProxy, 2)
         self.assertLess(1, twoProxy)
 
+    def test_gil_handoffs(self):
+        #a waiting thread runs once each time the caller hands off the GIL
+        state = dict(running=True, handoffs=0)
+        def waiter():
+            while state['running']:
+                state['handoffs'] += 1
+                time.sleep(0)
+        thread = threading.Thread(target=waiter)
+        thread.start()
+
+        numCalls = 10000
+        t0 = time.time()
+        for i in range(numCalls): self.env.convertObjectToProxy(i)
+        t1 = time.time()
+        state['running'] = False
+        thread.join()
+
+        print("GIL handoffs per call: %.2f (%.2f us/call)"%(
+            float(state['handoffs'])/numCalls, 1e6*(t1-t0)/numCalls))
+
+    def test_method_call_rate(self):
+        #method calls on managed proxies skip the failed field lookup after the first
+        dtype = self.env.findProxy("Pothos/DType")("float32")
+        self.assertEqual(dtype.size(), 4)
+
+        #and the bound call is reused rather than allocated per lookup
+        self.assertIs(dtype.size, dtype.size)
+
+        numCalls = 100000
+        t0 = time.time()
+        for i in range(numCalls): dtype.size()
+        t1 = time.time()
+
+        print("proxy.method() calls per second: %.0f"%(numCalls/(t1-t0)))
+
+    def test_proxy_subclass(self):
+        #attribute calls work on instances of proxy subclasses
+        class SubProxy(Pothos.Proxy): pass
+        dtype = SubProxy(self.env.findProxy("Pothos/DType")("float32"))
+        self.assertEqual(dtype.size(), 4)
+        self.assertEqual(dtype.name(), "float32")
+
+    def test_port_types(self):
+        #local ports are called through the port pointer
+        collector = Pothos.BlockRegistry("/blocks/collector_sink", "int")
+        inPort = Pothos.InputPortBase(collector.input(0))
+        self.assertEqual(inPort.elements(), 0)
+        self.assertEqual(inPort.totalElements(), 0)
+        self.assertFalse(inPort.hasMessage())
+        feeder = Pothos.BlockRegistry("/blocks/feeder_source", "int")
+        outPort = Pothos.OutputPortBase(feeder.output(0))
+        self.assertEqual(outPort.totalElements(), 0)
+
+        #other ports are called through their proxy
+        class FakePort(object):
+            def elements(self): return 7
+            def totalElements(self): return 42
+            def hasMessage(self): return True
+            def consume(self, numElements): self.consumed = numElements
+            def produce(self, numElements): self.produced = numElements
+        fake = FakePort()
+        inPort = Pothos.InputPortBase(Pothos.Proxy(fake))
+        self.assertEqual(inPort.elements(), 7)
+        self.assertEqual(inPort.totalElements(), 42)
+        self.assertTrue(inPort.hasMessage())
+        inPort.consume(3)
+        self.assertEqual(fake.consumed, 3)
+        outPort = Pothos.OutputPortBase(Pothos.Proxy(fake))
+        outPort.produce(5)
+        self.assertEqual(fake.produced, 5)
+
+        #proxy subclasses are accepted, other objects are not
+        class SubProxy(Pothos.Proxy): pass
+        self.assertEqual(Pothos.InputPortBase(SubProxy(collector.input(0))).elements(), 0)
+        self.assertRaises(TypeError, Pothos.InputPortBase, fake)
+
     def test_block(self):
 
         #testing it through the proxy
@@ -92,6 +170,57 @@ class TestPothosModule(unittest.TestCase):
         self.assertEqual(npArr0.dtype, npArr1.dtype)
         np.testing.assert_array_equal(npArr0, npArr1)
 
+    def test_label_range(self):
+        #a source that labels elements 1 and 3 of its only output
+        class LabelSource(Pothos.Block):
+            def __init__(self):
+                Pothos.Block.__init__(self)
+                self.setupOutput("0", "int")
+                self.done = False
+            def work(self):
+                if self.done or self.output(0).elements() < 4: return
+                self.output(0).postLabel(Pothos.Label("lbl", "a", 1, 1))
+                self.output(0).postLabel(Pothos.Label("lbl", "b", 3, 1))
+                self.output(0).buffer()[:4] = 0
+                self.output(0).produce(4)
+                self.done = True
+
+        #a sink that records labels through indexes() and the list conversion
+        class LabelRecorder(Pothos.Block):
+            def __init__(self):
+                Pothos.Block.__init__(self)
+                self.setupInput("0", "int")
+                self.indexes = list()
+                self.data = list()
+                self.dtypes = list()
+            def work(self):
+                n = self.input(0).elements()
+                if not n: return
+                offset = self.input(0).totalElements()
+                labels = self.input(0).labels()
+                indexes = labels.indexes()
+                self.dtypes.append(indexes.dtype)
+                self.indexes.extend(int(i)+offset for i in indexes)
+                self.data.extend(l.data for l in labels)
+                self.input(0).consume(n)
+
+        source = LabelSource()
+        recorder = LabelRecorder()
+        topology = Pothos.Topology()
+        topology.connect(source, 0, recorder, 0)
+        topology.commit()
+        topology.waitInactive()
+        topology.disconnectAll()
+        topology.commit()
+
+        self.assertEqual(recorder.indexes, [1, 3])
+        self.assertEqual(recorder.data, ["a", "b"])
+        for dtype in recorder.dtypes: self.assertEqual(dtype, np.int64)
+
+        #ranges that are not local fall back to the proxy calls
+        self.assertTrue(Pothos.labelRangeToList(Pothos.Proxy(None)) is None)
+        self.assertTrue(Pothos.labelRangeIndexes(Pothos.Proxy(None)) is None)
+
     def test_packet_type(self):
         pkt0 = Pothos.Packet()
         pkt0.payload = np.array([1, 2, 3], np.int32)
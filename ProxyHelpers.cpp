@@ -1,9 +1,10 @@
-// Copyright (c) 2014-2014 Josh Blum
+// Copyright (c) 2014-2026 Josh Blum
 // SPDX-License-Identifier: BSL-1.0
 
 #include "PythonProxy.hpp"
 #include <Pothos/Plugin.hpp>
 #include <cassert>
+#include <future>
 
 /***********************************************************************
  * PyObject helpers - used in python bindings
@@ -20,10 +21,22 @@ static PyObject *convertProxyToPyObject(const Pothos::Proxy &proxy)
     return std::dynamic_pointer_cast<PythonProxyHandle>(proxy.getHandle())->ref.newRef();
 }
 
+/***********************************************************************
+ * Async call helper - queue a call without waiting on the GIL
+ **********************************************************************/
+static std::shared_future<Pothos::Object> callProxyAsync(const Pothos::Proxy &proxy, const std::string &name, const std::vector<Pothos::Object> &args)
+{
+    auto env = std::dynamic_pointer_cast<PythonProxyEnvironment>(proxy.getEnvironment());
+    if (not env) throw Pothos::ProxyHandleCallError("callProxyAsync()", "not a python proxy");
+    return env->callAsync(proxy, name, args.data(), args.size()).share();
+}
+
 pothos_static_block(pothosRegisterPyObjectHelpers)
 {
     Pothos::PluginRegistry::add("/proxy_helpers/python/pyobject_to_proxy",
         PyObjectToProxyFcn(&convertPyObjectToProxy));
     Pothos::PluginRegistry::add("/proxy_helpers/python/proxy_to_pyobject",
         ProxyToPyObjectFcn(&convertProxyToPyObject));
+    Pothos::PluginRegistry::addCall("/proxy_helpers/python/call_async",
+        &callProxyAsync);
 }
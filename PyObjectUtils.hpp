@@ -1,12 +1,34 @@
-// Copyright (c) 2014-2014 Josh Blum
+// Copyright (c) 2014-2026 Josh Blum
 // SPDX-License-Identifier: BSL-1.0
 
 #pragma once
 #include <Python.h>
 #include <Pothos/Proxy.hpp>
+#include <atomic>
 #include <functional>
 #include <iostream>
 
+/***********************************************************************
+ * Vectorcall protocol (PEP 590) is available in python 3.8 and later,
+ * using the provisional names in 3.8 that became public in 3.9
+ **********************************************************************/
+#if PY_VERSION_HEX >= 0x03080000
+#define POTHOS_PY_VECTORCALL
+#if PY_VERSION_HEX < 0x03090000
+#define PyObject_Vectorcall _PyObject_Vectorcall
+#define Py_TPFLAGS_HAVE_VECTORCALL _Py_TPFLAGS_HAVE_VECTORCALL
+#endif
+#endif
+
+/***********************************************************************
+ * Per-object critical sections (PEP 703) are available in python 3.13,
+ * they only lock in free-threaded builds and are plain scopes otherwise
+ **********************************************************************/
+#if PY_VERSION_HEX < 0x030D0000
+#define Py_BEGIN_CRITICAL_SECTION(op) {
+#define Py_END_CRITICAL_SECTION() }
+#endif
+
 /***********************************************************************
  * Conversion function pointer types
  **********************************************************************/
@@ -64,10 +86,21 @@ struct PyObjectRef
 /***********************************************************************
  * C++ locking structures for calling into and out of the interpreter
  **********************************************************************/
+//! The number of times a PyGilStateLock took the GIL from another thread
+//! (re-entry on a thread that holds it is not counted), per library
+inline std::atomic<unsigned long long> &pyGilAcquisitions(void)
+{
+    static std::atomic<unsigned long long> count(0);
+    return count;
+}
+
 struct PyGilStateLock
 {
     PyGILState_STATE _s;
-    PyGilStateLock(void):_s(PyGILState_Ensure()){}
+    PyGilStateLock(void):_s(PyGILState_Ensure())
+    {
+        if (_s == PyGILState_UNLOCKED) pyGilAcquisitions()++;
+    }
     ~PyGilStateLock(void){PyGILState_Release(_s);}
 };
 
@@ -77,3 +110,24 @@ struct PyThreadStateLock
     PyThreadStateLock(void):_s(PyEval_SaveThread()){}
     ~PyThreadStateLock(void){PyEval_RestoreThread(_s);}
 };
+
+/***********************************************************************
+ * Mutex for C++ state that the GIL protects in default builds.
+ * Free-threaded builds use a PyMutex, which detaches the thread state
+ * while blocked so a waiting thread cannot stall the interpreter.
+ **********************************************************************/
+#ifdef Py_GIL_DISABLED
+struct PyStateMutex
+{
+    PyStateMutex(void):_m(){}
+    void lock(void){PyMutex_Lock(&_m);}
+    void unlock(void){PyMutex_Unlock(&_m);}
+    PyMutex _m;
+};
+#else
+struct PyStateMutex
+{
+    void lock(void){}
+    void unlock(void){}
+};
+#endif
@@ -1,16 +1,73 @@
-// Copyright (c) 2014-2016 Josh Blum
+// Copyright (c) 2014-2026 Josh Blum
 // SPDX-License-Identifier: BSL-1.0
 
+#include "PythonProxy.hpp"
+#include "PythonExecutor.hpp"
 #include <Pothos/Framework.hpp>
 #include <Pothos/Managed.hpp>
 #include <Pothos/Proxy.hpp>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <set>
+
+/***********************************************************************
+ * Lookup a method function on the class of the python block.
+ * Functions are resolved from the type rather than the instance so the
+ * cache does not hold a bound method (and a strong ref) to the block.
+ **********************************************************************/
+static PyObjectRef lookupTypeFunction(PyObject *type, const char *name)
+{
+    PyObjectRef attr(PyObject_GetAttrString(type, name), REF_NEW);
+    if (attr.obj == nullptr) PyErr_Clear();
+    #if PY_MAJOR_VERSION < 3
+    //unbound methods are created on each access, compare the functions
+    else if (PyMethod_Check(attr.obj)) return PyObjectRef(PyMethod_GET_FUNCTION(attr.obj), REF_BORROWED);
+    #endif
+    return attr;
+}
 
 class PythonBlock : Pothos::Block
 {
 public:
-    PythonBlock(void)
+    PythonBlock(void):
+        _minWorkElements(0),
+        _minWorkBytes(0),
+        _workFlushTimeout(std::chrono::milliseconds(10)),
+        _workPending(false),
+        _workHeld(false),
+        _workHeldElements(0),
+        _avoidedWorkCalls(0),
+        _flushArmed(false),
+        _flushDone(false)
     {
         this->registerCall(this, POTHOS_FCN_TUPLE(PythonBlock, _setPyBlock));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PythonBlock, setPythonExecutor));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PythonBlock, getPythonExecutorStats));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PythonBlock, setMinWorkElements));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PythonBlock, getMinWorkElements));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PythonBlock, setMinWorkBytes));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PythonBlock, getMinWorkBytes));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PythonBlock, setWorkFlushTimeout));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PythonBlock, getAvoidedWorkCalls));
+        this->registerCall(this, POTHOS_FCN_TUPLE(PythonBlock, _flushWork));
+        this->registerSlot("_flushWork");
+    }
+
+    ~PythonBlock(void)
+    {
+        this->stopWorkFlush();
+        if (not _env) return;
+        PyGilStateLock lock;
+        _workFcn = PyObjectRef();
+        _workArraysFcn = PyObjectRef();
+        _activateFcn = PyObjectRef();
+        _deactivateFcn = PyObjectRef();
+        _propagateLabelsFcn = PyObjectRef();
     }
 
     static Block *make(void)
@@ -21,43 +78,413 @@ public:
     void _setPyBlock(const Pothos::Proxy &block)
     {
         _block = block;
+
+        //resolve the dispatch table once, otherwise fall back to calls by name
+        auto handle = std::dynamic_pointer_cast<PythonProxyHandle>(block.getHandle());
+        if (not handle) return;
+        _env = handle->env;
+        if (_env->getExecutorThreads() != 0) this->setPythonExecutor(_env->getExecutorThreads());
+
+        PyGilStateLock lock;
+        const auto self = this->getPySelf();
+        PyObjectRef type((PyObject *)Py_TYPE(self.obj), REF_BORROWED);
+        _workFcn = lookupTypeFunction(type.obj, "work");
+        _workArraysFcn = lookupTypeFunction(type.obj, "workArrays");
+        _activateFcn = lookupTypeFunction(type.obj, "activate");
+        _deactivateFcn = lookupTypeFunction(type.obj, "deactivate");
+        _propagateLabelsFcn = lookupTypeFunction(type.obj, "propagateLabelsAdaptor");
+        if (_workFcn.obj == nullptr)
+        {
+            _workArraysFcn = PyObjectRef();
+            _activateFcn = PyObjectRef();
+            _deactivateFcn = PyObjectRef();
+            _propagateLabelsFcn = PyObjectRef();
+            _env.reset();
+            return;
+        }
+
+        //methods left as the no-op defaults in Pothos.Block are never called
+        PyObjectRef module(PyImport_ImportModule("Pothos.Block"), REF_NEW);
+        PyObjectRef base((module.obj == nullptr)? nullptr : PyObject_GetAttrString(module.obj, "Block"), REF_NEW);
+        if (base.obj == nullptr) PyErr_Clear();
+        else
+        {
+            auto isDefault = [&base, &type](const char *name)
+            {
+                return lookupTypeFunction(type.obj, name).obj == lookupTypeFunction(base.obj, name).obj;
+            };
+            if (isDefault("activate")) _activateFcn = PyObjectRef();
+            if (isDefault("deactivate")) _deactivateFcn = PyObjectRef();
+            if (isDefault("propagateLabels")) _propagateLabelsFcn = PyObjectRef();
+        }
+    }
+
+    /*!
+     * Run this block's python calls on dedicated executor threads.
+     * Blocks are spread round-robin over numThreads executors,
+     * and 0 returns to calling python from the worker threads.
+     */
+    void setPythonExecutor(const size_t numThreads)
+    {
+        if (numThreads == 0) _executor.reset();
+        else _executor = PythonExecutor::get(numThreads);
+    }
+
+    //! Queue depth and queued-to-run latency of this block's executor
+    Pothos::ObjectKwargs getPythonExecutorStats(void)
+    {
+        Pothos::ObjectKwargs stats;
+        if (not _executor) return stats;
+        const auto executorStats = _executor->getStats();
+        stats["queueDepth"] = Pothos::Object(executorStats.queueDepth);
+        stats["totalCalls"] = Pothos::Object(executorStats.totalCalls);
+        stats["meanLatencyUs"] = Pothos::Object(executorStats.meanLatencyUs);
+        stats["maxLatencyUs"] = Pothos::Object(executorStats.maxLatencyUs);
+        return stats;
+    }
+
+    /*!
+     * Skip calling into python until every input has this many elements.
+     * A flush timeout still calls work() on a smaller tail; 0 disables.
+     */
+    void setMinWorkElements(const size_t numElements)
+    {
+        _minWorkElements = numElements;
+    }
+
+    size_t getMinWorkElements(void) const
+    {
+        return _minWorkElements;
+    }
+
+    //! Skip calling into python until every input has this many bytes
+    void setMinWorkBytes(const size_t numBytes)
+    {
+        _minWorkBytes = numBytes;
+    }
+
+    size_t getMinWorkBytes(void) const
+    {
+        return _minWorkBytes;
+    }
+
+    //! Call work() on a partial input after this many seconds
+    void setWorkFlushTimeout(const double timeout)
+    {
+        _workFlushTimeout = std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(
+            std::chrono::duration<double>(timeout));
+    }
+
+    //! The number of held input states that did not enter python
+    unsigned long long getAvoidedWorkCalls(void) const
+    {
+        return _avoidedWorkCalls;
+    }
+
+    //! Posted by the flush thread, the message wakes the scheduler to call work()
+    void _flushWork(void)
+    {
+        return;
     }
 
     void work(void)
     {
-        _block.call("work");
+        //a held input state counts once it is superseded by more input,
+        //repeated work() calls on the same input state are not counted
+        const bool hold = this->holdWork();
+        const auto elements = this->workInfo().minInElements;
+        if (_workHeld and elements != _workHeldElements) _avoidedWorkCalls++;
+        _workHeld = hold;
+        _workHeldElements = elements;
+        if (hold) return;
+        if (_workPending) this->disarmWorkFlush();
+        _workPending = false;
+
+        this->dispatch([this]
+        {
+            if (not _env) _block.call("work");
+            else if (_workArraysFcn.obj != nullptr) this->callWorkArrays();
+            else this->callPyFunction(_workFcn);
+        });
     }
 
     void activate(void)
     {
-        _block.call("activate");
+        this->dispatch([this]
+        {
+            if (not _env) _block.call("activate");
+            else if (_activateFcn.obj != nullptr) this->callPyFunction(_activateFcn);
+        });
     }
 
     void deactivate(void)
     {
-        _block.call("deactivate");
+        this->stopWorkFlush();
+        this->dispatch([this]
+        {
+            if (not _env) _block.call("deactivate");
+            else if (_deactivateFcn.obj != nullptr) this->callPyFunction(_deactivateFcn);
+        });
     }
 
     void propagateLabels(const Pothos::InputPort *input, const Pothos::LabelIteratorRange &labels)
     {
-        _block.call("propagateLabelsAdaptor", input, labels);
+        this->dispatch([this, input, &labels]
+        {
+            if (not _env) _block.call("propagateLabelsAdaptor", input, labels);
+            else if (_propagateLabelsFcn.obj != nullptr)
+            {
+                const auto inputArg = _env->makeProxy(input);
+                const auto labelsArg = _env->makeProxy(labels);
+                this->callPyFunction(_propagateLabelsFcn, _env->getHandle(inputArg)->obj, _env->getHandle(labelsArg)->obj);
+            }
+        });
     }
 
     Pothos::Object opaqueCallHandler(const std::string &name, const Pothos::Object *inputArgs, const size_t numArgs)
     {
-        if (name == "_setPyBlock") return Pothos::Block::opaqueCallHandler(name, inputArgs, numArgs);
+        static const std::set<std::string> blockCalls{
+            "_setPyBlock", "setPythonExecutor", "getPythonExecutorStats",
+            "setMinWorkElements", "getMinWorkElements", "setMinWorkBytes",
+            "getMinWorkBytes", "setWorkFlushTimeout", "getAvoidedWorkCalls", "_flushWork"};
+        if (blockCalls.count(name) != 0) return Pothos::Block::opaqueCallHandler(name, inputArgs, numArgs);
         if (not _block) throw name;
-        auto env = _block.getEnvironment();
-        Pothos::ProxyVector args(numArgs);
-        for (size_t i = 0; i < numArgs; i++)
+        Pothos::Object ret;
+        this->dispatch([&]
         {
-            args[i] = env->convertObjectToProxy(inputArgs[i]);
-        }
-        auto result = _block.getHandle()->call(name, args.data(), args.size());
-        return env->convertProxyToObject(result);
+            auto env = _block.getEnvironment();
+            Pothos::ProxyVector args(numArgs);
+            for (size_t i = 0; i < numArgs; i++)
+            {
+                args[i] = env->convertObjectToProxy(inputArgs[i]);
+            }
+            auto result = _block.getHandle()->call(name, args.data(), args.size());
+            ret = env->convertProxyToObject(result);
+        });
+        return ret;
     }
 
     Pothos::Proxy _block;
+
+private:
+
+    //! Should work() hold off on python until more input is available?
+    bool holdWork(void)
+    {
+        if (_minWorkElements == 0 and _minWorkBytes == 0) return false;
+        if (this->inputs().empty()) return false;
+
+        size_t minBytes = std::numeric_limits<size_t>::max();
+        for (auto input : this->inputs())
+        {
+            if (input->hasMessage()) return false;
+            minBytes = std::min(minBytes, input->buffer().length);
+        }
+        if (this->workInfo().minInElements >= _minWorkElements and minBytes >= _minWorkBytes) return false;
+
+        //nothing to drain, wait on the next input event
+        if (this->workInfo().minInElements == 0) return true;
+
+        //a partial input is flushed after the timeout
+        const auto now = std::chrono::high_resolution_clock::now();
+        if (not _workPending)
+        {
+            _workPending = true;
+            _workPendingSince = now;
+        }
+        const auto deadline = _workPendingSince + _workFlushTimeout;
+        if (now >= deadline) return false;
+
+        //return without blocking the worker thread,
+        //the flush thread calls back into work() at the deadline
+        this->armWorkFlush(deadline);
+        return true;
+    }
+
+    //! Schedule a wakeup of this block at the flush deadline
+    void armWorkFlush(const std::chrono::high_resolution_clock::time_point &deadline)
+    {
+        std::lock_guard<std::mutex> lock(_flushMutex);
+        if (not _flushThread.joinable()) _flushThread = std::thread(&PythonBlock::flushLoop, this);
+        _flushDeadline = deadline;
+        _flushArmed = true;
+        _flushCond.notify_one();
+    }
+
+    void disarmWorkFlush(void)
+    {
+        std::lock_guard<std::mutex> lock(_flushMutex);
+        _flushArmed = false;
+    }
+
+    void stopWorkFlush(void)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_flushMutex);
+            _flushDone = true;
+            _flushArmed = false;
+            _flushCond.notify_one();
+        }
+        if (_flushThread.joinable()) _flushThread.join();
+        _flushThread = std::thread();
+        _flushDone = false;
+    }
+
+    //! Sleeps off the worker thread, posts to the flush slot when a deadline expires
+    void flushLoop(void)
+    {
+        std::unique_lock<std::mutex> lock(_flushMutex);
+        while (not _flushDone)
+        {
+            if (not _flushArmed) _flushCond.wait(lock);
+            else if (_flushCond.wait_until(lock, _flushDeadline) == std::cv_status::timeout and _flushArmed)
+            {
+                _flushArmed = false;
+                lock.unlock();
+                this->input("_flushWork")->pushMessage(Pothos::Object(Pothos::ObjectVector()));
+                lock.lock();
+            }
+        }
+    }
+
+    //! Run on the executor when one is set, otherwise on the calling thread
+    template <typename Fcn>
+    void dispatch(const Fcn &fcn)
+    {
+        if (_executor) _executor->call(fcn);
+        else fcn();
+    }
+
+    //! The python block is passed in as a weakref.proxy, get the referent (None when gone)
+    PyObjectRef getPySelf(void) const
+    {
+        auto obj = std::dynamic_pointer_cast<PythonProxyHandle>(_block.getHandle())->obj;
+        if (not PyWeakref_Check(obj)) return PyObjectRef(obj, REF_BORROWED);
+        #if PY_VERSION_HEX >= 0x030D0000
+        //a strong reference, the referent may be released by another thread
+        PyObject *self = nullptr;
+        if (PyWeakref_GetRef(obj, &self) == 1) return PyObjectRef(self, REF_NEW);
+        PyErr_Clear();
+        return PyObjectRef(Py_None, REF_BORROWED);
+        #else
+        return PyObjectRef(PyWeakref_GetObject(obj), REF_BORROWED);
+        #endif
+    }
+
+    //! Call the cached function with the block as self, args are borrowed
+    template <typename... Args>
+    void callPyFunction(const PyObjectRef &fcn, Args... args)
+    {
+        PyGilStateLock lock;
+        const auto self = this->getPySelf();
+        if (self.obj == Py_None) throw Pothos::ProxyExceptionMessage("python block no longer exists");
+        PyObjectRef result(PyObject_CallFunctionObjArgs(fcn.obj, self.obj, args..., nullptr), REF_NEW);
+        if (result.obj == nullptr) throw Pothos::ProxyExceptionMessage(getErrorString());
+    }
+
+    /*!
+     * Call workArrays(inputs, outputs) with tuples of ndarrays for the indexed ports.
+     * The result is (consumed, produced), each an int applied to every port,
+     * a sequence with one count per port, or None; None skips both.
+     */
+    void callWorkArrays(void)
+    {
+        PyGilStateLock lock;
+        const auto self = this->getPySelf();
+        if (self.obj == Py_None) throw Pothos::ProxyExceptionMessage("python block no longer exists");
+
+        const auto &inputs = this->inputs();
+        const auto &outputs = this->outputs();
+        PyObjectRef inArrays(PyTuple_New(inputs.size()), REF_NEW);
+        PyObjectRef outArrays(PyTuple_New(outputs.size()), REF_NEW);
+        for (size_t i = 0; i < inputs.size(); i++)
+        {
+            PyTuple_SET_ITEM(inArrays.obj, i, this->makeArray(inputs[i]->buffer()));
+        }
+        for (size_t i = 0; i < outputs.size(); i++)
+        {
+            PyTuple_SET_ITEM(outArrays.obj, i, this->makeArray(outputs[i]->buffer()));
+        }
+
+        PyObjectRef result(PyObject_CallFunctionObjArgs(_workArraysFcn.obj, self.obj, inArrays.obj, outArrays.obj, nullptr), REF_NEW);
+        if (result.obj == nullptr) throw Pothos::ProxyExceptionMessage(getErrorString());
+        if (result.obj == Py_None) return;
+        if (not PyTuple_Check(result.obj) or PyTuple_GET_SIZE(result.obj) != 2)
+        {
+            throw Pothos::ProxyExceptionMessage("workArrays() must return (consumed, produced) or None");
+        }
+
+        const auto consumed = this->parseCounts(PyTuple_GET_ITEM(result.obj, 0), inputs.size());
+        const auto produced = this->parseCounts(PyTuple_GET_ITEM(result.obj, 1), outputs.size());
+        for (size_t i = 0; i < consumed.size(); i++)
+        {
+            if (consumed[i] != 0) inputs[i]->consume(consumed[i]);
+        }
+        for (size_t i = 0; i < produced.size(); i++)
+        {
+            if (produced[i] != 0) outputs[i]->produce(produced[i]);
+        }
+    }
+
+    //! Make a new ndarray reference for a port buffer (GIL held)
+    PyObject *makeArray(const Pothos::BufferChunk &buffer)
+    {
+        const auto proxy = _env->makeProxy(buffer);
+        return _env->getHandle(proxy)->ref.newRef();
+    }
+
+    //! Parse an int for every port or a sequence of per-port counts (GIL held)
+    static std::vector<size_t> parseCounts(PyObject *obj, const size_t numPorts)
+    {
+        std::vector<size_t> counts;
+        if (obj == Py_None) return counts;
+        if (PySequence_Check(obj))
+        {
+            PyObjectRef seq(PySequence_Fast(obj, "expected a sequence of counts"), REF_NEW);
+            if (seq.obj == nullptr) throw Pothos::ProxyExceptionMessage(getErrorString());
+            if (size_t(PySequence_Fast_GET_SIZE(seq.obj)) != numPorts)
+            {
+                throw Pothos::ProxyExceptionMessage("workArrays() counts do not match the number of ports");
+            }
+            for (size_t i = 0; i < numPorts; i++)
+            {
+                counts.push_back(parseCount(PySequence_Fast_GET_ITEM(seq.obj, i)));
+            }
+            return counts;
+        }
+        counts.assign(numPorts, parseCount(obj));
+        return counts;
+    }
+
+    static size_t parseCount(PyObject *obj)
+    {
+        const auto count = PyNumber_AsSsize_t(obj, PyExc_OverflowError);
+        if (count == -1 and PyErr_Occurred()) throw Pothos::ProxyExceptionMessage(getErrorString());
+        if (count < 0) throw Pothos::ProxyExceptionMessage("workArrays() counts must not be negative");
+        return size_t(count);
+    }
+
+    std::shared_ptr<PythonProxyEnvironment> _env;
+    PyObjectRef _workFcn;
+    PyObjectRef _workArraysFcn;
+    PyObjectRef _activateFcn;
+    PyObjectRef _deactivateFcn;
+    PyObjectRef _propagateLabelsFcn;
+    std::shared_ptr<PythonExecutor> _executor;
+    size_t _minWorkElements;
+    size_t _minWorkBytes;
+    std::chrono::high_resolution_clock::duration _workFlushTimeout;
+    bool _workPending;
+    std::chrono::high_resolution_clock::time_point _workPendingSince;
+    bool _workHeld;
+    size_t _workHeldElements;
+    unsigned long long _avoidedWorkCalls;
+    std::thread _flushThread;
+    std::mutex _flushMutex;
+    std::condition_variable _flushCond;
+    bool _flushArmed;
+    bool _flushDone;
+    std::chrono::high_resolution_clock::time_point _flushDeadline;
 };
 
 static Pothos::BlockRegistry registerPythonBlock(
@@ -1,4 +1,4 @@
-// Copyright (c) 2016-2017 Josh Blum
+// Copyright (c) 2016-2026 Josh Blum
 // SPDX-License-Identifier: BSL-1.0
 
 #include <Pothos/System/Version.hpp>
@@ -7,10 +7,14 @@
 #include <Pothos/Plugin.hpp>
 #include <Pothos/System.hpp>
 #include <Pothos/Proxy.hpp>
+#include <Pothos/Remote.hpp>
+#include <Pothos/Util/Network.hpp>
 #include <Poco/Path.h>
 #include <Poco/File.h>
 #include <Poco/StringTokenizer.h>
+#include <memory>
 #include <tuple>
+#include <vector>
 #include <map>
 
 /***********************************************************************
@@ -39,6 +43,88 @@ static std::vector<Poco::Path> getPythonFiles(const Poco::Path &path)
     return paths;
 }
 
+/***********************************************************************
+ * Child process hosts: each block gets its own server process.
+ * The block proxy is wrapped in a handle that owns the server,
+ * so the process is stopped once the block is released.
+ *
+ * Calls and buffers reach the child through the framework's remote
+ * transport over a loopback TCP socket, not through shared memory:
+ * every buffer is serialized and copied into and out of the socket.
+ * A child process isolates a block's interpreter and its crashes,
+ * it does not make streaming faster than an in-process block.
+ **********************************************************************/
+struct ChildProcessHost
+{
+    //the environment is released before the server stops
+    std::shared_ptr<Pothos::RemoteServer> server;
+    Pothos::ProxyEnvironment::Sptr env;
+};
+
+class ChildProcessProxyHandle : public Pothos::ProxyHandle
+{
+public:
+    ChildProcessProxyHandle(const std::shared_ptr<ChildProcessHost> &host, const std::shared_ptr<Pothos::ProxyHandle> &handle):
+        _env(host, host->env.get()),
+        _handle(handle)
+    {
+        return;
+    }
+
+    Pothos::ProxyEnvironment::Sptr getEnvironment(void) const
+    {
+        return _env;
+    }
+
+    Pothos::Proxy call(const std::string &name, const Pothos::Proxy *args, const size_t numArgs)
+    {
+        std::vector<Pothos::Proxy> unwrapped(numArgs);
+        for (size_t i = 0; i < numArgs; i++) unwrapped[i] = unwrap(args[i]);
+        return _handle->call(name, unwrapped.data(), unwrapped.size());
+    }
+
+    int compareTo(const Pothos::Proxy &proxy) const
+    {
+        return _handle->compareTo(unwrap(proxy));
+    }
+
+    size_t hashCode(void) const
+    {
+        return _handle->hashCode();
+    }
+
+    std::string toString(void) const
+    {
+        return _handle->toString();
+    }
+
+    std::string getClassName(void) const
+    {
+        return _handle->getClassName();
+    }
+
+private:
+    //the remote handle expects its own handle type for other child blocks
+    static Pothos::Proxy unwrap(const Pothos::Proxy &proxy)
+    {
+        auto wrapped = std::dynamic_pointer_cast<ChildProcessProxyHandle>(proxy.getHandle());
+        return wrapped? Pothos::Proxy(wrapped->_handle) : proxy;
+    }
+
+    //aliases the host environment and keeps the host alive
+    Pothos::ProxyEnvironment::Sptr _env;
+    std::shared_ptr<Pothos::ProxyHandle> _handle;
+};
+
+static std::shared_ptr<ChildProcessHost> makeChildProcessHost(const Pothos::ProxyEnvironmentArgs &envArgs)
+{
+    auto host = std::make_shared<ChildProcessHost>();
+    host->server = std::make_shared<Pothos::RemoteServer>("tcp://"+Pothos::Util::getLoopbackAddr());
+    Pothos::RemoteClient client("tcp://"+Pothos::Util::getLoopbackAddr(host->server->getActualPort()));
+    host->env = client.makeEnvironment("python", envArgs);
+    return host;
+}
+
 /***********************************************************************
  * The loader factory opens a python environment,
  * locates the specified module and class (or function),
@@ -48,11 +134,14 @@ static Pothos::Object opaquePythonLoaderFactory(
     const std::vector<Poco::Path> &modulePaths,
     const std::string &moduleName,
     const std::string &functionName,
+    const Pothos::ProxyEnvironmentArgs &envArgs,
+    const bool childProcess,
     const Pothos::Object *args,
     const size_t numArgs)
 {
-    //create python environment
-    auto env = Pothos::ProxyEnvironment::make("python");
+    //create python environment, in-process or in a child process host
+    auto host = childProcess? makeChildProcessHost(envArgs) : nullptr;
+    auto env = childProcess? host->env : Pothos::ProxyEnvironment::make("python", envArgs);
 
     //add to the system path
     auto sys = env->findProxy("sys");
@@ -83,6 +172,7 @@ static Pothos::Object opaquePythonLoaderFactory(
 
     //call into the factory
     auto block = mod.getHandle()->call(functionName, proxyArgs.data(), proxyArgs.size());
+    if (host) block = Pothos::Proxy(std::make_shared<ChildProcessProxyHandle>(host, block.getHandle()));
     return Pothos::Object(block);
 }
 
@@ -157,6 +247,29 @@ static std::vector<Pothos::PluginPath> PythonLoader(const std::map<std::string,
         modulePaths.push_back(Poco::Path(path).makeAbsolute(rootDir));
     }
 
+    //environment args in the format key=value
+    Pothos::ProxyEnvironmentArgs envArgs;
+    const auto environmentIt = config.find("environment");
+    if (environmentIt != config.end()) for (const auto &arg :
+        Poco::StringTokenizer(environmentIt->second, tokSep, tokOptions))
+    {
+        const auto equalPos = arg.find('=');
+        if (equalPos == std::string::npos or equalPos == 0)
+        {
+            throw Pothos::Exception("environment entry not in format key=value");
+        }
+        envArgs[arg.substr(0, equalPos)] = arg.substr(equalPos+1);
+    }
+
+    //process: "local" (default) or "child" to host each block in its own process
+    bool childProcess = false;
+    const auto processIt = config.find("process");
+    if (processIt != config.end())
+    {
+        if (processIt->second == "child") childProcess = true;
+        else if (processIt->second != "local") throw Pothos::Exception("process not local or child");
+    }
+
     //register for all factory paths
     for (const auto &factoryTuple : factories)
     {
@@ -164,7 +277,9 @@ static std::vector<Pothos::PluginPath> PythonLoader(const std::map<std::string,
         const auto factory = Pothos::Callable(&opaquePythonLoaderFactory)
             .bind(modulePaths, 0)
             .bind(std::get<1>(factoryTuple), 1)
-            .bind(std::get<2>(factoryTuple), 2);
+            .bind(std::get<2>(factoryTuple), 2)
+            .bind(envArgs, 3)
+            .bind(childProcess, 4);
         Pothos::PluginRegistry::addCall(pluginPath, factory);
         entries.push_back(pluginPath);
     }
@@ -1,12 +1,17 @@
-// Copyright (c) 2013-2020 Josh Blum
+// Copyright (c) 2013-2026 Josh Blum
 //                    2019 Nicholas Corgan
 // SPDX-License-Identifier: BSL-1.0
 
 #include <Pothos/Plugin.hpp>
+#include <Pothos/Framework/BufferChunk.hpp>
 #include <cassert>
+#include <cstring>
 #include <complex>
 #include <iostream>
+#include <iterator>
 #include <type_traits>
+#include <typeindex>
+#include <unordered_map>
 #include <Poco/Types.h>
 #include "PythonProxy.hpp"
 
@@ -272,6 +277,31 @@ static std::vector<char> convertPyBytesToString(const Pothos::Proxy &proxy)
     return std::vector<char>(c, c+PyBytes_Size(obj));
 }
 
+bool convertPyByteBufferToObject(PyObject *obj, Pothos::Object &result)
+{
+    if (not PyObject_CheckBuffer(obj)) return false;
+    Py_buffer view;
+    if (PyObject_GetBuffer(obj, &view, PyBUF_FULL_RO) != 0)
+    {
+        PyErr_Clear();
+        return false;
+    }
+
+    //only byte formats, other buffers convert through their own converters
+    const char *format = (view.format == nullptr)? "B" : view.format;
+    if (*format == '@' or *format == '=' or *format == '<' or *format == '>' or *format == '!') format++;
+    const bool isBytes = view.itemsize == 1 and format[1] == '\0' and
+        (format[0] == 'B' or format[0] == 'b' or format[0] == 'c');
+    if (isBytes)
+    {
+        std::vector<char> vec(view.len);
+        PyBuffer_ToContiguous(vec.data(), &view, view.len, 'C');
+        result = Pothos::Object(std::move(vec));
+    }
+    PyBuffer_Release(&view);
+    return isBytes;
+}
+
 pothos_static_block(pothosRegisterPythonBytesConversions)
 {
     Pothos::PluginRegistry::addCall("/proxy/converters/python/vecchar_to_pybytes",
@@ -284,6 +314,78 @@ pothos_static_block(pothosRegisterPythonBytesConversions)
         Pothos::ProxyConvertPair("bytes", &convertPyBytesToString));
 }
 
+/***********************************************************************
+ * byte storage -- exports the vector held by a Pothos::Object through
+ * the buffer protocol, so a read-only memoryview needs no copy.
+ * The storage shares ownership of the object: like a posted message,
+ * the vector must not be modified once it has been converted.
+ **********************************************************************/
+struct ByteStorageObject
+{
+    PyObject_HEAD
+    Pothos::Object *storage;
+    void *data;
+    Py_ssize_t size;
+};
+
+static PyTypeObject ByteStorageType = {
+    PyObject_HEAD_INIT(NULL)
+};
+
+static PyBufferProcs ByteStorageBufferProcs = {
+};
+
+static void ByteStorage_dealloc(ByteStorageObject *self)
+{
+    delete self->storage;
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+static int ByteStorage_getbuffer(ByteStorageObject *self, Py_buffer *view, int flags)
+{
+    return PyBuffer_FillInfo(view, (PyObject *)self, self->data, self->size, 1/*readonly*/, flags);
+}
+
+static bool initByteStorageType(void)
+{
+    ByteStorageType.tp_name = "PothosByteStorage";
+    ByteStorageType.tp_basicsize = sizeof(ByteStorageObject);
+    ByteStorageType.tp_dealloc = (destructor)ByteStorage_dealloc;
+    ByteStorageType.tp_flags = Py_TPFLAGS_DEFAULT;
+    #if PY_MAJOR_VERSION < 3
+    ByteStorageType.tp_flags |= Py_TPFLAGS_HAVE_NEWBUFFER;
+    #endif
+    ByteStorageType.tp_doc = "Pothos byte vector storage";
+    ByteStorageType.tp_as_buffer = &ByteStorageBufferProcs;
+    ByteStorageBufferProcs.bf_getbuffer = (getbufferproc)ByteStorage_getbuffer;
+    return PyType_Ready(&ByteStorageType) == 0;
+}
+
+template <typename ByteType>
+static PyObject *byteVectorToPyMemoryView(const Pothos::Object &obj)
+{
+    static const bool ready = initByteStorageType();
+    if (not ready) return nullptr;
+
+    //the storage object keeps the vector alive as long as the view
+    auto storage = PyObject_New(ByteStorageObject, &ByteStorageType);
+    if (storage == nullptr) return nullptr;
+    storage->storage = new Pothos::Object(obj);
+    const auto &vec = storage->storage->extract<std::vector<ByteType>>();
+    storage->data = const_cast<ByteType *>(vec.data());
+    storage->size = Py_ssize_t(vec.size());
+    PyObjectRef storageRef((PyObject *)storage, REF_NEW);
+    return PyMemoryView_FromObject(storageRef.obj);
+}
+
+PyObject *convertByteVectorToPyMemoryView(const Pothos::Object &obj)
+{
+    if (obj.type() == typeid(std::vector<char>)) return byteVectorToPyMemoryView<char>(obj);
+    if (obj.type() == typeid(std::vector<signed char>)) return byteVectorToPyMemoryView<signed char>(obj);
+    if (obj.type() == typeid(std::vector<unsigned char>)) return byteVectorToPyMemoryView<unsigned char>(obj);
+    return nullptr;
+}
+
 /***********************************************************************
  * numeric
  **********************************************************************/
@@ -367,25 +469,172 @@ pothos_static_block(pothosRegisterPythonNumericConversions)
         &convertComplexVectorToPyList<double>);
 }
 
+/***********************************************************************
+ * sequences of builtin numbers -- a list or tuple of only int, float
+ * and complex elements converts into a snapshot tuple, which is read
+ * into a typed vector in one pass without a proxy per element.
+ * The per-element ProxyVector is only made when it is asked for.
+ **********************************************************************/
+struct PyNumberSequence
+{
+    Pothos::Proxy tuple;
+};
+
+static bool isPyNumber(PyObject *obj)
+{
+    const auto type = Py_TYPE(obj);
+    #if PY_MAJOR_VERSION < 3
+    if (type == &PyInt_Type) return true;
+    #endif
+    return type == &PyFloat_Type or type == &PyLong_Type or type == &PyComplex_Type;
+}
+
+//! Is a list or tuple non-empty and made only of builtin numbers? (GIL held)
+static bool isPyNumberSequence(PyObject *seq)
+{
+    const auto size = PySequence_Fast_GET_SIZE(seq);
+    const auto items = PySequence_Fast_ITEMS(seq);
+    for (Py_ssize_t i = 0; i < size; i++)
+    {
+        if (not isPyNumber(items[i])) return false;
+    }
+    return size != 0;
+}
+
+template <typename T>
+static bool pyNumberToNumber(PyObject *obj, T &out)
+{
+    const auto type = Py_TYPE(obj);
+    if (type == &PyFloat_Type)
+    {
+        out = T(PyFloat_AS_DOUBLE(obj));
+        return true;
+    }
+    #if PY_MAJOR_VERSION < 3
+    if (type == &PyInt_Type)
+    {
+        out = T(PyInt_AS_LONG(obj));
+        return true;
+    }
+    #endif
+    if (type == &PyLong_Type)
+    {
+        //integers out of range for long long use the generic path
+        int overflow(0);
+        const auto num = PyLong_AsLongLongAndOverflow(obj, &overflow);
+        if (overflow != 0) return false;
+        out = T(num);
+        return true;
+    }
+    return false;
+}
+
+template <typename T>
+static bool pyNumberToNumber(PyObject *obj, std::complex<T> &out)
+{
+    if (Py_TYPE(obj) == &PyComplex_Type)
+    {
+        const auto c = PyComplex_AsCComplex(obj);
+        out = std::complex<T>(T(c.real), T(c.imag));
+        return true;
+    }
+    T real(0);
+    if (not pyNumberToNumber(obj, real)) return false;
+    out = std::complex<T>(real);
+    return true;
+}
+
+template <typename T>
+static std::vector<T> convertPyNumberSequenceToVector(const PyNumberSequence &seq)
+{
+    auto handle = std::dynamic_pointer_cast<PythonProxyHandle>(seq.tuple.getHandle());
+    PyGilStateLock lock;
+    std::vector<T> out(PyTuple_GET_SIZE(handle->obj));
+    for (size_t i = 0; i < out.size(); i++)
+    {
+        //elements the fast path cannot represent convert through their proxy
+        PyObject *item = PyTuple_GET_ITEM(handle->obj, i);
+        if (not pyNumberToNumber(item, out[i])) out[i] = handle->env->makeHandle(item, REF_BORROWED).template convert<T>();
+    }
+    return out;
+}
+
+static Pothos::ProxyVector convertPyNumberSequenceToProxyVector(const PyNumberSequence &seq)
+{
+    auto handle = std::dynamic_pointer_cast<PythonProxyHandle>(seq.tuple.getHandle());
+    PyGilStateLock lock;
+    Pothos::ProxyVector vec(PyTuple_GET_SIZE(handle->obj));
+    for (size_t i = 0; i < vec.size(); i++)
+    {
+        vec[i] = handle->env->makeHandle(PyTuple_GET_ITEM(handle->obj, i), REF_BORROWED);
+    }
+    return vec;
+}
+
+static Pothos::Proxy convertPyNumberSequenceToPyList(Pothos::ProxyEnvironment::Sptr env, const PyNumberSequence &seq)
+{
+    auto pyenv = std::dynamic_pointer_cast<PythonProxyEnvironment>(env);
+    return pyenv->makeHandle(PySequence_List(pyenv->getHandle(seq.tuple)->obj), REF_NEW);
+}
+
+pothos_static_block(pothosRegisterPythonNumberSequenceConversions)
+{
+    Pothos::PluginRegistry::addCall("/proxy/converters/python/number_sequence_to_pylist",
+        &convertPyNumberSequenceToPyList);
+    Pothos::PluginRegistry::addCall("/object/convert/python/number_sequence_to_proxy_vector",
+        &convertPyNumberSequenceToProxyVector);
+
+    const std::string prefix("/object/convert/python/number_sequence_to_vec");
+    Pothos::PluginRegistry::addCall(prefix+"schar", &convertPyNumberSequenceToVector<signed char>);
+    Pothos::PluginRegistry::addCall(prefix+"uchar", &convertPyNumberSequenceToVector<unsigned char>);
+    Pothos::PluginRegistry::addCall(prefix+"sshort", &convertPyNumberSequenceToVector<signed short>);
+    Pothos::PluginRegistry::addCall(prefix+"ushort", &convertPyNumberSequenceToVector<unsigned short>);
+    Pothos::PluginRegistry::addCall(prefix+"sint", &convertPyNumberSequenceToVector<signed int>);
+    Pothos::PluginRegistry::addCall(prefix+"uint", &convertPyNumberSequenceToVector<unsigned int>);
+    Pothos::PluginRegistry::addCall(prefix+"slong", &convertPyNumberSequenceToVector<signed long>);
+    Pothos::PluginRegistry::addCall(prefix+"ulong", &convertPyNumberSequenceToVector<unsigned long>);
+    Pothos::PluginRegistry::addCall(prefix+"sllong", &convertPyNumberSequenceToVector<signed long long>);
+    Pothos::PluginRegistry::addCall(prefix+"ullong", &convertPyNumberSequenceToVector<unsigned long long>);
+    Pothos::PluginRegistry::addCall(prefix+"float", &convertPyNumberSequenceToVector<float>);
+    Pothos::PluginRegistry::addCall(prefix+"double", &convertPyNumberSequenceToVector<double>);
+    Pothos::PluginRegistry::addCall(prefix+"complexfloat", &convertPyNumberSequenceToVector<std::complex<float>>);
+    Pothos::PluginRegistry::addCall(prefix+"complexdouble", &convertPyNumberSequenceToVector<std::complex<double>>);
+}
+
+/***********************************************************************
+ * containers -- python handles are used directly,
+ * other proxies are converted through the environment
+ **********************************************************************/
+static std::shared_ptr<PythonProxyHandle> getPyHandle(const std::shared_ptr<PythonProxyEnvironment> &env, const Pothos::Proxy &proxy)
+{
+    auto handle = std::dynamic_pointer_cast<PythonProxyHandle>(proxy.getHandle());
+    if (handle) return handle;
+    return env->getHandle(proxy);
+}
+
 /***********************************************************************
  * tuple
  **********************************************************************/
-static Pothos::ProxyVector convertPyTupleToVector(const Pothos::Proxy &proxy)
+static Pothos::Object convertPyTupleToObject(const Pothos::Proxy &proxy)
 {
     auto env = std::dynamic_pointer_cast<PythonProxyEnvironment>(proxy.getEnvironment());
     auto obj = std::dynamic_pointer_cast<PythonProxyHandle>(proxy.getHandle())->obj;
+
+    //a tuple is immutable, so it is its own snapshot
+    if (isPyNumberSequence(obj)) return Pothos::Object(PyNumberSequence{proxy});
+
     Pothos::ProxyVector vec(PyTuple_Size(obj));
     for (size_t i = 0; i < vec.size(); i++)
     {
         vec[i] = env->makeHandle(PyTuple_GetItem(obj, i), REF_BORROWED);
     }
-    return vec;
+    return Pothos::Object(vec);
 }
 
 pothos_static_block(pothosRegisterPythonTupleConversions)
 {
     Pothos::PluginRegistry::add("/proxy/converters/python/pytuple_to_vector",
-        Pothos::ProxyConvertPair("tuple", &convertPyTupleToVector));
+        Pothos::ProxyConvertPair("tuple", &convertPyTupleToObject));
 }
 
 /***********************************************************************
@@ -397,21 +646,33 @@ static Pothos::Proxy convertVectorToPyList(Pothos::ProxyEnvironment::Sptr env, c
     PyObjectRef pyList(PyList_New(vec.size()), REF_NEW);
     for (size_t i = 0; i < vec.size(); i++)
     {
-        PyList_SetItem(pyList.obj, i, pyenv->getHandle(vec[i])->ref.newRef());
+        PyList_SetItem(pyList.obj, i, getPyHandle(pyenv, vec[i])->ref.newRef());
     }
     return pyenv->makeHandle(pyList);
 }
 
-static Pothos::ProxyVector convertPyListToVector(const Pothos::Proxy &proxy)
+static Pothos::Object convertPyListToObject(const Pothos::Proxy &proxy)
 {
     auto env = std::dynamic_pointer_cast<PythonProxyEnvironment>(proxy.getEnvironment());
     auto obj = std::dynamic_pointer_cast<PythonProxyHandle>(proxy.getHandle())->obj;
-    Pothos::ProxyVector vec(PyList_Size(obj));
-    for (size_t i = 0; i < vec.size(); i++)
+    Pothos::Object result;
+    Py_BEGIN_CRITICAL_SECTION(obj);
+    if (isPyNumberSequence(obj))
     {
-        vec[i] = env->makeHandle(PyList_GetItem(obj, i), REF_BORROWED);
+        //snapshot the elements, later changes to the list do not reach the result
+        result = Pothos::Object(PyNumberSequence{env->makeHandle(PyList_AsTuple(obj), REF_NEW)});
     }
-    return vec;
+    else
+    {
+        Pothos::ProxyVector vec(PyList_GET_SIZE(obj));
+        for (size_t i = 0; i < vec.size(); i++)
+        {
+            vec[i] = env->makeHandle(PyList_GET_ITEM(obj, i), REF_BORROWED);
+        }
+        result = Pothos::Object(vec);
+    }
+    Py_END_CRITICAL_SECTION();
+    return result;
 }
 
 pothos_static_block(pothosRegisterPythonListConversions)
@@ -419,7 +680,7 @@ pothos_static_block(pothosRegisterPythonListConversions)
     Pothos::PluginRegistry::addCall("/proxy/converters/python/vector_to_pylist",
         &convertVectorToPyList);
     Pothos::PluginRegistry::add("/proxy/converters/python/pylist_to_vector",
-        Pothos::ProxyConvertPair("list", &convertPyListToVector));
+        Pothos::ProxyConvertPair("list", &convertPyListToObject));
 }
 
 /***********************************************************************
@@ -431,8 +692,7 @@ static Pothos::Proxy convertSetToPySet(Pothos::ProxyEnvironment::Sptr env, const
     PyObjectRef pySet(PySet_New(nullptr), REF_NEW);
     for (const auto &entry : set)
     {
-        auto obj = pyenv->getHandle(entry)->obj;
-        PySet_Add(pySet.obj, obj);
+        PySet_Add(pySet.obj, getPyHandle(pyenv, entry)->obj);
     }
     return pyenv->makeHandle(pySet);
 }
@@ -441,11 +701,15 @@ static Pothos::ProxySet convertPySetToSet(const Pothos::Proxy &proxy)
 {
     auto env = std::dynamic_pointer_cast<PythonProxyEnvironment>(proxy.getEnvironment());
     auto obj = std::dynamic_pointer_cast<PythonProxyHandle>(proxy.getHandle())->obj;
-    auto pySet = PySet_New(obj); //makes a copy which we pop from until empty
     Pothos::ProxySet set;
-    while (PySet_Size(pySet) != 0)
+    PyObjectRef iter(PyObject_GetIter(obj), REF_NEW);
+    if (iter.obj == nullptr) throw Pothos::ProxyEnvironmentConvertError("convertPySetToSet()", getErrorString());
+
+    //hint after the last insertion: keys that iterate in order cost one comparison
+    auto hint = set.end();
+    while (PyObject *item = PyIter_Next(iter.obj))
     {
-        set.insert(env->makeHandle(PySet_Pop(pySet), REF_NEW));
+        hint = std::next(set.emplace_hint(hint, env->makeHandle(item, REF_NEW)));
     }
     return set;
 }
@@ -464,11 +728,15 @@ pothos_static_block(pothosRegisterPythonSetConversions)
 static Pothos::Proxy convertMapToPyDict(Pothos::ProxyEnvironment::Sptr env, const Pothos::ProxyMap &d)
 {
     auto pyenv = std::dynamic_pointer_cast<PythonProxyEnvironment>(env);
+    #if PY_VERSION_HEX < 0x030D0000
+    PyObjectRef pyDict(_PyDict_NewPresized(Py_ssize_t(d.size())), REF_NEW);
+    #else
     PyObjectRef pyDict(PyDict_New(), REF_NEW);
+    #endif
     for (const auto &entry : d) PyDict_SetItem(
         pyDict.obj,
-        pyenv->getHandle(entry.first.getHandle())->obj,
-        pyenv->getHandle(entry.second.getHandle())->obj);
+        getPyHandle(pyenv, entry.first)->obj,
+        getPyHandle(pyenv, entry.second)->obj);
     return pyenv->makeHandle(pyDict);
 }
 
@@ -477,15 +745,15 @@ static Pothos::ProxyMap convertPyDictToMap(const Pothos::Proxy &proxy)
     auto env = std::dynamic_pointer_cast<PythonProxyEnvironment>(proxy.getEnvironment());
     auto obj = std::dynamic_pointer_cast<PythonProxyHandle>(proxy.getHandle())->obj;
     Pothos::ProxyMap d;
-    PyObjectRef items(PyDict_Items(obj), REF_NEW);
-    for (Py_ssize_t i = 0; i < PyList_Size(items.obj); i++)
+    Py_BEGIN_CRITICAL_SECTION(obj);
+    Py_ssize_t pos(0);
+    PyObject *key, *val;
+    auto hint = d.end();
+    while (PyDict_Next(obj, &pos, &key, &val))
     {
-        PyObject *item = PyList_GetItem(items.obj, i);
-        assert(PyTuple_Check(item) and PyTuple_Size(item) == 2);
-        auto key = env->makeHandle(PyTuple_GetItem(item, 0), REF_BORROWED);
-        auto val = env->makeHandle(PyTuple_GetItem(item, 1), REF_BORROWED);
-        d[key] = val;
+        hint = std::next(d.emplace_hint(hint, env->makeHandle(key, REF_BORROWED), env->makeHandle(val, REF_BORROWED)));
     }
+    Py_END_CRITICAL_SECTION();
     return d;
 }
 
@@ -496,3 +764,167 @@ pothos_static_block(pothosRegisterPythonDictConversions)
     Pothos::PluginRegistry::add("/proxy/converters/python/pydict_to_map",
         Pothos::ProxyConvertPair("dict", &convertPyDictToMap));
 }
+
+/***********************************************************************
+ * builtin scalar fast path
+ *
+ * PythonProxyEnvironment handles the most common scalar types inline
+ * before falling back to a search of the converter registry.
+ * The conversions match the registered converters above.
+ **********************************************************************/
+template <typename T>
+static EnableIfSigned<T, PyObject *> intToPyObject(const T &num)
+{
+    #if PY_MAJOR_VERSION >= 3
+    return PyLong_FromLong(long(num));
+    #else
+    return PyInt_FromLong(long(num));
+    #endif
+}
+
+template <typename T>
+static EnableIfUnsigned<T, PyObject *> intToPyObject(const T &num)
+{
+    #if PY_MAJOR_VERSION >= 3
+    return PyLong_FromUnsignedLong((unsigned long)(num));
+    #else
+    return PyInt_FromSize_t((size_t)(num));
+    #endif
+}
+
+template <typename T>
+static EnableIfSigned64<T, PyObject *> intToPyObject(const T &num)
+{
+    return PyLong_FromLongLong((long long)num);
+}
+
+template <typename T>
+static EnableIfUnsigned64<T, PyObject *> intToPyObject(const T &num)
+{
+    return PyLong_FromUnsignedLongLong((unsigned long long)num);
+}
+
+template <typename T>
+static PyObject *intObjectToPyObject(const Pothos::Object &obj)
+{
+    return intToPyObject(obj.extract<T>());
+}
+
+template <typename T>
+static PyObject *floatObjectToPyObject(const Pothos::Object &obj)
+{
+    return PyFloat_FromDouble(double(obj.extract<T>()));
+}
+
+template <typename T>
+static PyObject *complexObjectToPyObject(const Pothos::Object &obj)
+{
+    const auto &c = obj.extract<std::complex<T>>();
+    return PyComplex_FromDoubles(double(c.real()), double(c.imag()));
+}
+
+static PyObject *boolObjectToPyObject(const Pothos::Object &obj)
+{
+    return PyBool_FromLong(obj.extract<bool>());
+}
+
+static PyObject *stringObjectToPyObject(const Pothos::Object &obj)
+{
+    return StdStringToPyObject(obj.extract<std::string>());
+}
+
+static PyObject *nullObjectToPyObject(const Pothos::Object &)
+{
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+
+PyObject *convertBuiltinScalarToPyObject(const Pothos::Object &obj)
+{
+    typedef PyObject *(*ScalarToPyObjectFcn)(const Pothos::Object &);
+    static const std::unordered_map<std::type_index, ScalarToPyObjectFcn> fastPath{
+        {typeid(Pothos::NullObject), &nullObjectToPyObject},
+        {typeid(bool), &boolObjectToPyObject},
+        {typeid(char), &intObjectToPyObject<char>},
+        {typeid(signed char), &intObjectToPyObject<signed char>},
+        {typeid(unsigned char), &intObjectToPyObject<unsigned char>},
+        {typeid(signed short), &intObjectToPyObject<signed short>},
+        {typeid(unsigned short), &intObjectToPyObject<unsigned short>},
+        {typeid(signed int), &intObjectToPyObject<signed int>},
+        {typeid(unsigned int), &intObjectToPyObject<unsigned int>},
+        {typeid(signed long), &intObjectToPyObject<signed long>},
+        {typeid(unsigned long), &intObjectToPyObject<unsigned long>},
+        {typeid(signed long long), &intObjectToPyObject<signed long long>},
+        {typeid(unsigned long long), &intObjectToPyObject<unsigned long long>},
+        {typeid(float), &floatObjectToPyObject<float>},
+        {typeid(double), &floatObjectToPyObject<double>},
+        {typeid(std::complex<float>), &complexObjectToPyObject<float>},
+        {typeid(std::complex<double>), &complexObjectToPyObject<double>},
+        {typeid(std::string), &stringObjectToPyObject},
+    };
+    const auto it = fastPath.find(std::type_index(obj.type()));
+    if (it == fastPath.end()) return nullptr;
+    return it->second(obj);
+}
+
+bool convertPyBuiltinScalarToObject(PyObject *obj, Pothos::Object &result)
+{
+    const auto type = Py_TYPE(obj);
+    if (obj == Py_None) result = Pothos::Object();
+    else if (type == &PyBool_Type) result = Pothos::Object(bool(obj == Py_True));
+    else if (type == &PyFloat_Type) result = Pothos::Object(PyFloat_AsDouble(obj));
+    else if (type == &PyComplex_Type)
+    {
+        const auto c = PyComplex_AsCComplex(obj);
+        result = Pothos::Object(std::complex<double>(c.real, c.imag));
+    }
+    #if PY_MAJOR_VERSION >= 3
+    else if (type == &PyLong_Type)
+    {
+        int overflow(0);
+        const auto r = PyLong_AsLongLongAndOverflow(obj, &overflow);
+        if (overflow) result = Pothos::Object(PyLong_AsUnsignedLongLongMask(obj));
+        else result = Pothos::Object(r);
+    }
+    else if (type == &PyUnicode_Type) result = Pothos::Object(PyObjToStdString(obj));
+    #endif
+    else return false;
+    return true;
+}
+
+/***********************************************************************
+ * numeric vector to buffer chunk -- used by PythonProxyEnvironment
+ * when numeric vectors are converted into numpy arrays
+ **********************************************************************/
+template <typename T>
+static Pothos::BufferChunk numericVectorToBufferChunk(const Pothos::Object &obj)
+{
+    //copied: the caller may still modify the vector through its object
+    const auto &vec = obj.extract<std::vector<T>>();
+    Pothos::BufferChunk chunk(Pothos::DType(typeid(T)), vec.size());
+    std::memcpy(chunk.as<void *>(), vec.data(), vec.size()*sizeof(T));
+    return chunk;
+}
+
+bool convertNumericVectorToBufferChunk(const Pothos::Object &obj, Pothos::BufferChunk &result)
+{
+    typedef Pothos::BufferChunk (*VectorToChunkFcn)(const Pothos::Object &);
+    static const std::unordered_map<std::type_index, VectorToChunkFcn> vectorTypes{
+        {typeid(std::vector<signed short>), &numericVectorToBufferChunk<signed short>},
+        {typeid(std::vector<unsigned short>), &numericVectorToBufferChunk<unsigned short>},
+        {typeid(std::vector<signed int>), &numericVectorToBufferChunk<signed int>},
+        {typeid(std::vector<unsigned int>), &numericVectorToBufferChunk<unsigned int>},
+        {typeid(std::vector<signed long>), &numericVectorToBufferChunk<signed long>},
+        {typeid(std::vector<unsigned long>), &numericVectorToBufferChunk<unsigned long>},
+        {typeid(std::vector<signed long long>), &numericVectorToBufferChunk<signed long long>},
+        {typeid(std::vector<unsigned long long>), &numericVectorToBufferChunk<unsigned long long>},
+        {typeid(std::vector<float>), &numericVectorToBufferChunk<float>},
+        {typeid(std::vector<double>), &numericVectorToBufferChunk<double>},
+        {typeid(std::vector<std::complex<float>>), &numericVectorToBufferChunk<std::complex<float>>},
+        {typeid(std::vector<std::complex<double>>), &numericVectorToBufferChunk<std::complex<double>>},
+    };
+    const auto it = vectorTypes.find(std::type_index(obj.type()));
+    if (it == vectorTypes.end()) return false;
+    result = it->second(obj);
+    return true;
+}
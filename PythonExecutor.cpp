@@ -0,0 +1,169 @@
+// Copyright (c) 2026 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#include "PythonExecutor.hpp"
+#include "PyObjectUtils.hpp"
+#include <vector>
+#include <map>
+
+/***********************************************************************
+ * Does the calling thread hold the GIL?
+ **********************************************************************/
+static bool callerHoldsGil(void)
+{
+    #if PY_VERSION_HEX >= 0x03040000
+    return PyGILState_Check() != 0;
+    #else
+    PyThreadState *tstate = PyGILState_GetThisThreadState();
+    return tstate != nullptr and tstate == _PyThreadState_Current;
+    #endif
+}
+
+/***********************************************************************
+ * Process-wide pools keyed by thread count, executors are held weakly
+ **********************************************************************/
+struct PythonExecutorPool
+{
+    PythonExecutorPool(void):next(0){}
+    std::vector<std::weak_ptr<PythonExecutor>> executors;
+    size_t next;
+};
+
+std::shared_ptr<PythonExecutor> PythonExecutor::get(const size_t numThreads)
+{
+    static std::mutex mutex;
+    static std::map<size_t, PythonExecutorPool> pools;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto &pool = pools[numThreads];
+    if (pool.executors.empty()) pool.executors.resize(numThreads);
+    auto &entry = pool.executors[(pool.next++) % numThreads];
+    auto executor = entry.lock();
+    if (not executor)
+    {
+        executor = std::make_shared<PythonExecutor>();
+        entry = executor;
+    }
+    return executor;
+}
+
+/***********************************************************************
+ * Executor implementation
+ **********************************************************************/
+PythonExecutor::State::State(void):
+    done(false),
+    totalCalls(0),
+    totalLatency(0),
+    maxLatency(0)
+{
+    return;
+}
+
+PythonExecutor::PythonExecutor(void):
+    _state(std::make_shared<State>())
+{
+    _thread = std::thread(&PythonExecutor::run, _state);
+}
+
+PythonExecutor::~PythonExecutor(void)
+{
+    {
+        std::lock_guard<std::mutex> lock(_state->mutex);
+        _state->done = true;
+    }
+    _state->cond.notify_one();
+
+    //released by a call on the executor: the thread exits after that call
+    if (this->isExecutorThread()) _thread.detach();
+
+    //the executor needs the GIL to finish its last call
+    else if (callerHoldsGil())
+    {
+        PyThreadStateLock unlock;
+        _thread.join();
+    }
+    else _thread.join();
+}
+
+std::future<void> PythonExecutor::submit(std::function<void()> fcn)
+{
+    Task task;
+    task.fcn = std::packaged_task<void()>(std::move(fcn));
+    task.queued = std::chrono::high_resolution_clock::now();
+    auto future = task.fcn.get_future();
+    {
+        std::lock_guard<std::mutex> lock(_state->mutex);
+        _state->queue.push_back(std::move(task));
+    }
+    _state->cond.notify_one();
+    return future;
+}
+
+void PythonExecutor::call(std::function<void()> fcn)
+{
+    //a python call into another block on this executor would deadlock
+    if (this->isExecutorThread()) return fcn();
+
+    auto future = this->submit(std::move(fcn));
+    if (callerHoldsGil())
+    {
+        PyThreadStateLock unlock;
+        future.wait();
+    }
+    future.get();
+}
+
+bool PythonExecutor::isExecutorThread(void) const
+{
+    return std::this_thread::get_id() == _thread.get_id();
+}
+
+PythonExecutor::Stats PythonExecutor::getStats(void)
+{
+    std::lock_guard<std::mutex> lock(_state->mutex);
+    Stats stats;
+    stats.queueDepth = _state->queue.size();
+    stats.totalCalls = _state->totalCalls;
+    const auto totalUs = std::chrono::duration<double, std::micro>(_state->totalLatency).count();
+    stats.meanLatencyUs = (_state->totalCalls == 0)? 0.0 : totalUs/_state->totalCalls;
+    stats.maxLatencyUs = std::chrono::duration<double, std::micro>(_state->maxLatency).count();
+    return stats;
+}
+
+void PythonExecutor::run(std::shared_ptr<State> state)
+{
+    PyGilStateLock lock;
+    std::unique_lock<std::mutex> queueLock(state->mutex);
+    while (true)
+    {
+        if (state->queue.empty())
+        {
+            if (state->done) break;
+
+            //release the GIL only when there is nothing left to run,
+            //and reacquire it without the queue lock so submitters never wait on the GIL
+            {
+                PyThreadStateLock unlock;
+                state->cond.wait(queueLock, [&state]{return state->done or not state->queue.empty();});
+                queueLock.unlock();
+            }
+            queueLock.lock();
+            continue;
+        }
+
+        //the task is released without the queue lock,
+        //its captures may hold the last reference to this executor
+        {
+            auto task = std::move(state->queue.front());
+            state->queue.pop_front();
+            const auto latency = std::chrono::high_resolution_clock::now() - task.queued;
+            state->totalCalls++;
+            state->totalLatency += latency;
+            if (latency > state->maxLatency) state->maxLatency = latency;
+
+            queueLock.unlock();
+            task.fcn();
+        }
+        queueLock.lock();
+    }
+}
@@ -0,0 +1,83 @@
+// Copyright (c) 2026 Josh Blum
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+#include <functional>
+#include <condition_variable>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <memory>
+#include <mutex>
+#include <deque>
+
+/***********************************************************************
+ * A dedicated thread that runs python calls in submission order.
+ * The GIL stays held across consecutive calls and is only released
+ * while the queue is empty, so blocks sharing an executor run one
+ * after another rather than trading the GIL between worker threads.
+ **********************************************************************/
+class PythonExecutor
+{
+public:
+
+    /*!
+     * Get an executor from the process-wide pool of numThreads executors.
+     * Each thread count has its own pool and callers are assigned round-robin;
+     * executors are shut down once all callers release them.
+     */
+    static std::shared_ptr<PythonExecutor> get(const size_t numThreads);
+
+    PythonExecutor(void);
+
+    ~PythonExecutor(void);
+
+    //! Queue a call, the future holds any exception thrown by the call
+    std::future<void> submit(std::function<void()> fcn);
+
+    /*!
+     * Run a call on the executor and wait for it to complete.
+     * Calls from the executor thread run inline, and the GIL is
+     * released while waiting when the calling thread holds it.
+     */
+    void call(std::function<void()> fcn);
+
+    //! Is the calling thread this executor's thread?
+    bool isExecutorThread(void) const;
+
+    struct Stats
+    {
+        size_t queueDepth;
+        unsigned long long totalCalls;
+        double meanLatencyUs; //!< time from queued until the call starts
+        double maxLatencyUs;
+    };
+
+    Stats getStats(void);
+
+private:
+    struct Task
+    {
+        std::packaged_task<void()> fcn;
+        std::chrono::high_resolution_clock::time_point queued;
+    };
+
+    //! State shared with the thread, which may outlive the executor
+    //! when the last reference is released by a call on the executor
+    struct State
+    {
+        State(void);
+        std::mutex mutex;
+        std::condition_variable cond;
+        std::deque<Task> queue;
+        bool done;
+        unsigned long long totalCalls;
+        std::chrono::high_resolution_clock::duration totalLatency;
+        std::chrono::high_resolution_clock::duration maxLatency;
+    };
+
+    static void run(std::shared_ptr<State> state);
+
+    std::shared_ptr<State> _state;
+    std::thread _thread;
+};
@@ -1,8 +1,10 @@
-// Copyright (c) 2013-2017 Josh Blum
+// Copyright (c) 2013-2026 Josh Blum
 // SPDX-License-Identifier: BSL-1.0
 
 #include <Poco/Format.h>
 #include <cassert>
+#include <cmath>
+#include <functional>
 #include <iostream>
 #include "PythonProxy.hpp"
 
@@ -19,17 +21,92 @@ PythonProxyHandle::~PythonProxyHandle(void)
     ref = PyObjectRef();
 }
 
+/***********************************************************************
+ * Compare same-typed builtin numbers and strings with a single call,
+ * returns false when the types are not handled here
+ **********************************************************************/
+static bool isFloatNaN(PyObject *obj)
+{
+    return PyFloat_Check(obj) and std::isnan(PyFloat_AS_DOUBLE(obj));
+}
+
+static bool compareBuiltins(PyObject *lhs, PyObject *rhs, int &result)
+{
+    //NaN is unordered: it sorts after other values,
+    //and distinct NaN objects remain distinct keys like in a dict
+    const bool nanL = isFloatNaN(lhs), nanR = isFloatNaN(rhs);
+    if (nanL or nanR)
+    {
+        if (nanL != nanR) result = nanL? +1 : -1;
+        else result = (lhs == rhs)? 0 : (std::less<PyObject *>()(lhs, rhs)? -1 : +1);
+        return true;
+    }
+
+    if (Py_TYPE(lhs) != Py_TYPE(rhs)) return false;
+
+    if (PyFloat_CheckExact(lhs))
+    {
+        const double a = PyFloat_AS_DOUBLE(lhs), b = PyFloat_AS_DOUBLE(rhs);
+        result = (a < b)? -1 : ((a > b)? +1 : 0);
+        return true;
+    }
+
+    if (PyLong_CheckExact(lhs))
+    {
+        int overflowA(0), overflowB(0);
+        const long long a = PyLong_AsLongLongAndOverflow(lhs, &overflowA);
+        const long long b = PyLong_AsLongLongAndOverflow(rhs, &overflowB);
+        if (overflowA != 0 or overflowB != 0) return false;
+        result = (a < b)? -1 : ((a > b)? +1 : 0);
+        return true;
+    }
+
+    #if PY_MAJOR_VERSION >= 3
+    if (PyUnicode_CheckExact(lhs))
+    {
+        result = PyUnicode_Compare(lhs, rhs);
+        if (result != -1 or PyErr_Occurred() == nullptr) return true;
+        PyErr_Clear();
+        return false;
+    }
+    #else
+    if (PyInt_CheckExact(lhs))
+    {
+        const long a = PyInt_AS_LONG(lhs), b = PyInt_AS_LONG(rhs);
+        result = (a < b)? -1 : ((a > b)? +1 : 0);
+        return true;
+    }
+    #endif
+
+    return false;
+}
+
+//! Objects with different hashes cannot be equal (unhashable objects are unknown)
+static bool hashesDiffer(PyObject *lhs, PyObject *rhs)
+{
+    const auto hashL = PyObject_Hash(lhs);
+    const auto hashR = (hashL == -1)? -1 : PyObject_Hash(rhs);
+    if (hashL != -1 and hashR != -1) return hashL != hashR;
+    PyErr_Clear();
+    return false;
+}
+
 int PythonProxyHandle::compareTo(const Pothos::Proxy &proxy) const
 {
     PyGilStateLock lock;
-    int rEq = 0, rGt = 0, rLt = 0;
-    rEq = PyObject_RichCompareBool(obj, env->getHandle(proxy)->obj, Py_EQ);
-    if (rEq == 1) return 0;
-    if (rEq == -1) goto fail;
-    rGt = PyObject_RichCompareBool(obj, env->getHandle(proxy)->obj, Py_GT);
+    const auto other = env->getHandle(proxy);
+    int rCmp = 0, rEq = 0, rGt = 0, rLt = 0;
+    if (compareBuiltins(obj, other->obj, rCmp)) return rCmp;
+    if (not hashesDiffer(obj, other->obj))
+    {
+        rEq = PyObject_RichCompareBool(obj, other->obj, Py_EQ);
+        if (rEq == 1) return 0;
+        if (rEq == -1) goto fail;
+    }
+    rGt = PyObject_RichCompareBool(obj, other->obj, Py_GT);
     if (rGt == 1) return +1;
     if (rGt == -1) goto fail;
-    rLt = PyObject_RichCompareBool(obj, env->getHandle(proxy)->obj, Py_LT);
+    rLt = PyObject_RichCompareBool(obj, other->obj, Py_LT);
     if (rLt == 1) return -1;
     if (rLt == -1) goto fail;
     fail:
@@ -75,6 +152,35 @@ std::string PythonProxyHandle::getClassName(void) const
     return modNameStr + "." + clsNameStr;
 }
 
+/***********************************************************************
+ * Method calls without a bound method object (python 3.9 and later)
+ **********************************************************************/
+#if PY_VERSION_HEX >= 0x03090000
+#define POTHOS_PY_VECTORCALL_METHOD
+
+//! Is the name a plain function or method descriptor on the type?
+//! Other attributes (fields, properties, class methods) take the getattr path.
+static bool isTypeMethod(PyTypeObject *type, PyObject *name)
+{
+    PyObject *attr = _PyType_Lookup(type, name); //borrowed, does not raise
+    if (attr == nullptr) return false;
+    return PyFunction_Check(attr) or Py_TYPE(attr) == &PyMethodDescr_Type;
+}
+#endif
+
+static Pothos::Proxy makeCallResult(const std::shared_ptr<PythonProxyEnvironment> &env, const PyObjectRef &result)
+{
+    auto errorMsg = getErrorString();
+    if (not errorMsg.empty())
+    {
+        throw Pothos::ProxyExceptionMessage(errorMsg);
+    }
+
+    auto x = env->makeHandle(result);
+    if (env->isPothosProxy(result.obj)) return x.convert<Pothos::Proxy>();
+    return x;
+}
+
 Pothos::Proxy PythonProxyHandle::call(const std::string &name, const Pothos::Proxy *args, const size_t numArgs)
 {
     PyGilStateLock lock;
@@ -108,16 +214,43 @@ Pothos::Proxy PythonProxyHandle::call(const std::string &name, const Pothos::Pro
         return env->makeHandle(result);
     }
 
+    #ifdef POTHOS_PY_VECTORCALL_METHOD
+    /*******************************************************************
+     * Step 1a) call a method on the type with self as the first argument
+     ******************************************************************/
+    static const size_t maxMethodArgs = 8;
+    if (not name.empty() and name != "()" and numArgs <= maxMethodArgs)
+    {
+        auto pyName = env->getInternedName(name);
+        if (isTypeMethod(Py_TYPE(this->obj), pyName))
+        {
+            //the handles keep converted arguments alive for the call duration
+            std::shared_ptr<PythonProxyHandle> argHandles[maxMethodArgs];
+            PyObject *argsArray[maxMethodArgs+2]; //slot 0 is scratch for the callee
+            argsArray[1] = this->obj;
+            for (size_t i = 0; i < numArgs; i++)
+            {
+                argHandles[i] = env->getHandle(args[i]);
+                argsArray[i+2] = argHandles[i]->obj;
+            }
+            PyObjectRef result(PyObject_VectorcallMethod(pyName, argsArray+1,
+                (numArgs+1) | PY_VECTORCALL_ARGUMENTS_OFFSET, nullptr), REF_NEW);
+            return makeCallResult(env, result);
+        }
+    }
+    #endif
+
     /*******************************************************************
      * Step 1) locate the callable object
      ******************************************************************/
     PyObjectRef attrObj;
 
     if (name.empty() or name == "()") attrObj = PyObjectRef(ref);
-    else attrObj = PyObjectRef(PyObject_GetAttrString(this->obj, name.c_str()), REF_NEW);
+    else attrObj = PyObjectRef(PyObject_GetAttr(this->obj, env->getInternedName(name)), REF_NEW);
 
     if (attrObj.obj == nullptr)
     {
+        PyErr_Clear();
         throw Pothos::ProxyHandleCallError(
             "PythonProxyHandle::call("+name+")",
             Poco::format("no attribute on %s", this->toString()));
@@ -132,31 +265,39 @@ Pothos::Proxy PythonProxyHandle::call(const std::string &name, const Pothos::Pro
     }
 
     /*******************************************************************
-     * Step 2) create tuple of arguments
+     * Step 2) call into the callable object
      ******************************************************************/
-    PyObjectRef argsObj(PyTuple_New(numArgs), REF_NEW);
-    std::vector<std::shared_ptr<PythonProxyHandle>> argHandles(numArgs);
-    for (size_t i = 0; i < numArgs; i++)
+    PyObjectRef result;
+    #ifdef POTHOS_PY_VECTORCALL
+    static const size_t maxStackArgs = 8;
+    if (numArgs <= maxStackArgs)
     {
-        argHandles[i] = env->getHandle(args[i]);
-        PyTuple_SetItem(argsObj.obj, i, argHandles[i]->ref.newRef());
+        //the handles keep converted arguments alive for the call duration
+        std::shared_ptr<PythonProxyHandle> argHandles[maxStackArgs];
+        PyObject *argsArray[maxStackArgs+1]; //slot 0 is scratch for the callee
+        for (size_t i = 0; i < numArgs; i++)
+        {
+            argHandles[i] = env->getHandle(args[i]);
+            argsArray[i+1] = argHandles[i]->obj;
+        }
+        result = PyObjectRef(PyObject_Vectorcall(attrObj.obj, argsArray+1,
+            numArgs | PY_VECTORCALL_ARGUMENTS_OFFSET, nullptr), REF_NEW);
     }
-
-    /*******************************************************************
-     * Step 4) call into the callable object
-     ******************************************************************/
-    PyObjectRef result(PyObject_CallObject(attrObj.obj, argsObj.obj), REF_NEW);
-
-    /*******************************************************************
-     * Step 5) exception handling and reporting
-     ******************************************************************/
-    auto errorMsg = getErrorString();
-    if (not errorMsg.empty())
+    else
+    #endif
     {
-        throw Pothos::ProxyExceptionMessage(errorMsg);
+        PyObjectRef argsObj(PyTuple_New(numArgs), REF_NEW);
+        std::vector<std::shared_ptr<PythonProxyHandle>> argHandles(numArgs);
+        for (size_t i = 0; i < numArgs; i++)
+        {
+            argHandles[i] = env->getHandle(args[i]);
+            PyTuple_SetItem(argsObj.obj, i, argHandles[i]->ref.newRef());
+        }
+        result = PyObjectRef(PyObject_CallObject(attrObj.obj, argsObj.obj), REF_NEW);
     }
 
-    auto x = env->makeHandle(result);
-    if (x.getClassName() == "PothosProxy") return x.convert<Pothos::Proxy>();
-    return x;
+    /*******************************************************************
+     * Step 3) exception handling and reporting
+     ******************************************************************/
+    return makeCallResult(env, result);
 }
@@ -1,13 +1,20 @@
-// Copyright (c) 2013-2020 Josh Blum
+// Copyright (c) 2013-2026 Josh Blum
 // SPDX-License-Identifier: BSL-1.0
 
 #include "PythonSupport.hpp"
 #include "PythonProxy.hpp"
+#include "PythonExecutor.hpp"
 #include <Pothos/Plugin.hpp>
 #include <Pothos/Callable.hpp>
 #include <Poco/SingletonHolder.h>
 #include <Pothos/System/Paths.hpp>
+#include <Pothos/Framework/BufferChunk.hpp>
 #include <Poco/Path.h>
+#include <stdexcept>
+#include <cstring>
+#include <atomic>
+#include <mutex>
+#include <string>
 
 /***********************************************************************
  * Per process Python interp init and cleanup
@@ -36,18 +43,67 @@ static PythonInterpWrapper &getPythonInterpWrapper(void)
     return *sh.get();
 }
 
+/***********************************************************************
+ * Converter cache generation: bumped on any python converter change
+ **********************************************************************/
+static std::atomic<size_t> converterGeneration(0);
+
+static void handlePythonConverterEvent(const Pothos::Plugin &, const std::string &)
+{
+    converterGeneration++;
+}
+
 /***********************************************************************
  * PythonProxyEnvironment methods
  **********************************************************************/
-PythonProxyEnvironment::PythonProxyEnvironment(const Pothos::ProxyEnvironmentArgs &)
+PythonProxyEnvironment::PythonProxyEnvironment(const Pothos::ProxyEnvironmentArgs &args):
+    _proxyType(nullptr),
+    _numericVectorsAsArrays(false),
+    _byteVectorsAsMemoryViews(false),
+    _executorThreads(0),
+    _converterCacheGeneration(0)
+{
+    const auto numericVectorsIt = args.find("numeric_vectors");
+    if (numericVectorsIt != args.end()) _numericVectorsAsArrays = (numericVectorsIt->second == "ndarray");
+    const auto byteVectorsIt = args.find("byte_vectors");
+    if (byteVectorsIt != args.end()) _byteVectorsAsMemoryViews = (byteVectorsIt->second == "memoryview");
+
+    const auto executorIt = args.find("executor");
+    if (executorIt != args.end() and executorIt->second == "dedicated")
+    {
+        const auto threadsIt = args.find("executor_threads");
+        try
+        {
+            _executorThreads = (threadsIt == args.end())? 1 : std::stoul(threadsIt->second);
+        }
+        catch (const std::invalid_argument &)
+        {
+            throw Pothos::ProxyEnvironmentFactoryError(
+                "PythonProxyEnvironment()", "executor_threads is not a number: " + threadsIt->second);
+        }
+        catch (const std::out_of_range &)
+        {
+            throw Pothos::ProxyEnvironmentFactoryError(
+                "PythonProxyEnvironment()", "executor_threads is out of range: " + threadsIt->second);
+        }
+        if (_executorThreads == 0) throw Pothos::ProxyEnvironmentFactoryError(
+            "PythonProxyEnvironment()", "executor_threads must be at least 1");
+    }
+}
+
+PythonProxyEnvironment::~PythonProxyEnvironment(void)
 {
-    return;
+    if (not Py_IsInitialized()) return;
+    PyGilStateLock lock;
+    std::lock_guard<PyStateMutex> cacheLock(_cacheMutex);
+    _internedNames.clear();
+    _converterCache.clear();
 }
 
 Pothos::Proxy PythonProxyEnvironment::makeHandle(PyObject *obj, const bool borrowed)
 {
-    auto env = std::dynamic_pointer_cast<PythonProxyEnvironment>(this->shared_from_this());
-    return Pothos::Proxy(new PythonProxyHandle(env, obj, borrowed));
+    auto env = std::static_pointer_cast<PythonProxyEnvironment>(this->shared_from_this());
+    return Pothos::Proxy(std::make_shared<PythonProxyHandle>(env, obj, borrowed));
 }
 
 Pothos::Proxy PythonProxyEnvironment::makeHandle(const PyObjectRef &ref)
@@ -77,9 +133,83 @@ Pothos::Proxy PythonProxyEnvironment::findProxy(const std::string &name)
     return this->makeHandle(module);
 }
 
+PyObject *PythonProxyEnvironment::getInternedName(const std::string &name)
+{
+    std::lock_guard<PyStateMutex> lock(_cacheMutex);
+    auto it = _internedNames.find(name);
+    if (it != _internedNames.end()) return it->second.obj;
+
+    #if PY_MAJOR_VERSION >= 3
+    PyObjectRef nameObj(PyUnicode_InternFromString(name.c_str()), REF_NEW);
+    #else
+    PyObjectRef nameObj(PyString_InternFromString(name.c_str()), REF_NEW);
+    #endif
+    _internedNames[name] = nameObj;
+    return nameObj.obj;
+}
+
+bool PythonProxyEnvironment::isPothosProxy(PyObject *obj)
+{
+    //the type is identified by name once, then by the type pointer
+    auto type = Py_TYPE(obj);
+    const auto proxyType = _proxyType.load();
+    if (type == proxyType) return true;
+    if (proxyType != nullptr) return false;
+    if (std::strcmp(type->tp_name, "PothosProxy") != 0) return false;
+    _proxyType = type;
+    return true;
+}
+
+std::future<Pothos::Object> PythonProxyEnvironment::callAsync(const Pothos::Proxy &proxy, const std::string &name, const Pothos::Object *args, const size_t numArgs)
+{
+    std::shared_ptr<PythonExecutor> executor;
+    {
+        std::lock_guard<std::mutex> lock(_asyncMutex);
+        if (not _asyncExecutor) _asyncExecutor = std::make_shared<PythonExecutor>();
+        executor = _asyncExecutor;
+    }
+
+    auto env = std::static_pointer_cast<PythonProxyEnvironment>(this->shared_from_this());
+    auto promise = std::make_shared<std::promise<Pothos::Object>>();
+    const std::vector<Pothos::Object> objArgs(args, args+numArgs);
+    executor->submit([env, promise, proxy, name, objArgs]
+    {
+        try
+        {
+            Pothos::ProxyVector proxyArgs(objArgs.size());
+            for (size_t i = 0; i < objArgs.size(); i++)
+            {
+                if (objArgs[i].type() == typeid(Pothos::Proxy)) proxyArgs[i] = objArgs[i].extract<Pothos::Proxy>();
+                else proxyArgs[i] = env->convertObjectToProxy(objArgs[i]);
+            }
+            const auto result = proxy.getHandle()->call(name, proxyArgs.data(), proxyArgs.size());
+            promise->set_value(env->convertProxyToObject(result));
+        }
+        catch (...)
+        {
+            promise->set_exception(std::current_exception());
+        }
+    });
+    return promise->get_future();
+}
+
 Pothos::Proxy PythonProxyEnvironment::convertObjectToProxy(const Pothos::Object &local)
 {
     PyGilStateLock lock;
+    auto scalar = convertBuiltinScalarToPyObject(local);
+    if (scalar != nullptr) return this->makeHandle(scalar, REF_NEW);
+    if (_byteVectorsAsMemoryViews)
+    {
+        auto view = convertByteVectorToPyMemoryView(local);
+        if (view != nullptr) return this->makeHandle(view, REF_NEW);
+        if (PyErr_Occurred()) throw Pothos::ProxyEnvironmentConvertError(
+            "PythonProxyEnvironment::convertObjectToProxy()", getErrorString());
+    }
+    Pothos::BufferChunk chunk;
+    if (_numericVectorsAsArrays and convertNumericVectorToBufferChunk(local, chunk))
+    {
+        return Pothos::ProxyEnvironment::convertObjectToProxy(Pothos::Object(chunk));
+    }
     try
     {
         return Pothos::ProxyEnvironment::convertObjectToProxy(local);
@@ -92,10 +222,61 @@ Pothos::Proxy PythonProxyEnvironment::convertObjectToProxy(const Pothos::Object
     }
 }
 
+Pothos::Callable PythonProxyEnvironment::getConverter(const PythonProxyHandle &handle)
+{
+    auto type = Py_TYPE(handle.obj);
+    const size_t generation = converterGeneration;
+    {
+        std::lock_guard<PyStateMutex> lock(_cacheMutex);
+        if (_converterCacheGeneration != generation)
+        {
+            _converterCache.clear();
+            _converterCacheGeneration = generation;
+        }
+        auto it = _converterCache.find(type);
+        if (it != _converterCache.end()) return it->second.converter;
+    }
+
+    //search the registry by class name, an empty callable means no converter
+    CachedConverter entry;
+    entry.type = PyObjectRef((PyObject *)type, REF_BORROWED);
+    const auto className = handle.getClassName();
+    const Pothos::PluginPath converters("/proxy/converters/python");
+    for (const auto &name : Pothos::PluginRegistry::list(converters))
+    {
+        const auto &obj = Pothos::PluginRegistry::get(converters.join(name)).getObject();
+        if (obj.type() != typeid(Pothos::ProxyConvertPair)) continue;
+        const auto &pair = obj.extract<Pothos::ProxyConvertPair>();
+        if (pair.first != className) continue;
+        entry.converter = pair.second;
+        break;
+    }
+
+    std::lock_guard<PyStateMutex> lock(_cacheMutex);
+    if (_converterCacheGeneration == generation) _converterCache[type] = entry;
+    return entry.converter;
+}
+
 Pothos::Object PythonProxyEnvironment::convertProxyToObject(const Pothos::Proxy &proxy)
 {
     PyGilStateLock lock;
-    auto r = Pothos::ProxyEnvironment::convertProxyToObject(proxy);
+    Pothos::Object r;
+    auto handle = std::dynamic_pointer_cast<PythonProxyHandle>(proxy.getHandle());
+    if (handle and convertPyBuiltinScalarToObject(handle->obj, r)) return r;
+    if (not handle) r = Pothos::ProxyEnvironment::convertProxyToObject(proxy);
+    else
+    {
+        //the registry was already searched for this type,
+        //a miss copies byte buffers and otherwise keeps the proxy
+        const auto converter = this->getConverter(*handle);
+        if (not converter)
+        {
+            if (convertPyByteBufferToObject(handle->obj, r)) return r;
+            return Pothos::Object(proxy);
+        }
+        const Pothos::Object arg(proxy);
+        r = converter.opaqueCall(&arg, 1);
+    }
     if (r.type() == typeid(Pothos::Object)) return r.extract<Pothos::Object>();
     return r;
 }
@@ -164,4 +345,7 @@ pothos_static_block(pothosRegisterPythonProxy)
     Pothos::PluginRegistry::addCall(
         "/proxy/environment/python",
         &makePythonProxyEnvironment);
+    Pothos::PluginRegistry::addCall(
+        "/proxy/converters/python",
+        &handlePythonConverterEvent);
 }
@@ -1,4 +1,4 @@
-// Copyright (c) 2013-2014 Josh Blum
+// Copyright (c) 2013-2026 Josh Blum
 // SPDX-License-Identifier: BSL-1.0
 
 #pragma once
@@ -7,8 +7,14 @@
 #include <Pothos/Proxy.hpp>
 #include <Pothos/Callable.hpp>
 #include <string>
+#include <unordered_map>
+#include <atomic>
+#include <future>
+#include <mutex>
+#include <cstddef>
 
 class PythonProxyHandle;
+class PythonExecutor;
 
 inline std::string PyObjToStdString(PyObject *o)
 {
@@ -46,8 +52,39 @@ inline std::string getErrorString(void)
     return errorMsg;
 }
 
+/***********************************************************************
+ * builtin scalar fast path conversions (GIL held)
+ **********************************************************************/
+
+//! Convert a builtin C++ scalar, returns a new reference or null when not handled
+PyObject *convertBuiltinScalarToPyObject(const Pothos::Object &obj);
+
+//! Convert a builtin python scalar, returns false when not handled
+bool convertPyBuiltinScalarToObject(PyObject *obj, Pothos::Object &result);
+
+namespace Pothos { class BufferChunk; }
+
+//! Convert a numeric std::vector into a buffer chunk, returns false when not handled
+bool convertNumericVectorToBufferChunk(const Pothos::Object &obj, Pothos::BufferChunk &result);
+
+//! Reference a byte std::vector with a read-only memoryview, returns null when not handled
+PyObject *convertByteVectorToPyMemoryView(const Pothos::Object &obj);
+
+//! Copy a buffer object with a byte format into a std::vector<char>, returns false when not handled
+bool convertPyByteBufferToObject(PyObject *obj, Pothos::Object &result);
+
 /***********************************************************************
  * custom Python environment overload
+ *
+ * Supported environment args:
+ *  - numeric_vectors: "list" (default) or "ndarray" to convert
+ *    numeric std::vector types into numpy arrays
+ *  - byte_vectors: "bytes" (default) or "memoryview" to reference
+ *    byte std::vector types with a read-only memoryview (no copy,
+ *    the vector must not be modified once converted)
+ *  - executor: "worker" (default) runs python blocks on the framework's
+ *    worker threads, "dedicated" queues their calls to executor threads
+ *  - executor_threads: number of dedicated executor threads (default 1)
  **********************************************************************/
 class PythonProxyEnvironment :
     public Pothos::ProxyEnvironment
@@ -55,6 +92,8 @@ class PythonProxyEnvironment :
 public:
     PythonProxyEnvironment(const Pothos::ProxyEnvironmentArgs &);
 
+    ~PythonProxyEnvironment(void);
+
     Pothos::Proxy makeHandle(PyObject *obj, const bool borrowed);
     Pothos::Proxy makeHandle(const PyObjectRef &ref);
 
@@ -67,10 +106,57 @@ public:
 
     Pothos::Proxy findProxy(const std::string &name);
 
+    //! Get an interned python string for an attribute name (borrowed, GIL held)
+    PyObject *getInternedName(const std::string &name);
+
+    //! Is the object a PothosProxy from the python module? (GIL held)
+    bool isPothosProxy(PyObject *obj);
+
+    /*!
+     * Queue a call for the environment's python thread and return immediately.
+     * This is the asynchronous call API, also registered for use outside
+     * this module as /proxy_helpers/python/call_async.
+     * The thread holds the GIL across consecutive queued calls, so a batch of
+     * control calls shares one acquisition. Arguments are converted into
+     * python and the result out of python on that thread; arguments that are
+     * already python proxies are used as-is. Only a result without a C++
+     * conversion stays a proxy, and releasing it takes the GIL.
+     */
+    std::future<Pothos::Object> callAsync(const Pothos::Proxy &proxy, const std::string &name, const Pothos::Object *args, const size_t numArgs);
+
+    //! The number of dedicated executor threads for python blocks, 0 for none
+    size_t getExecutorThreads(void) const
+    {
+        return _executorThreads;
+    }
+
     Pothos::Proxy convertObjectToProxy(const Pothos::Object &local);
     Pothos::Object convertProxyToObject(const Pothos::Proxy &proxy);
     void serialize(const Pothos::Proxy &, std::ostream &);
     Pothos::Proxy deserialize(std::istream &);
+
+private:
+    //! Lookup the proxy to object converter for a python type (GIL held)
+    Pothos::Callable getConverter(const PythonProxyHandle &handle);
+
+    //! Guards the caches below in free-threaded builds
+    PyStateMutex _cacheMutex;
+    std::unordered_map<std::string, PyObjectRef> _internedNames;
+    std::atomic<PyTypeObject *> _proxyType;
+    bool _numericVectorsAsArrays;
+    bool _byteVectorsAsMemoryViews;
+    size_t _executorThreads;
+    std::mutex _asyncMutex;
+    std::shared_ptr<PythonExecutor> _asyncExecutor;
+
+    //! Converter cache, the type ref keeps the key from being reused
+    struct CachedConverter
+    {
+        PyObjectRef type;
+        Pothos::Callable converter;
+    };
+    std::unordered_map<PyTypeObject *, CachedConverter> _converterCache;
+    size_t _converterCacheGeneration;
 };
 
 /***********************************************************************
@@ -0,0 +1,33 @@
+# Copyright (c) 2026 Josh Blum
+# SPDX-License-Identifier: BSL-1.0
+
+import Pothos
+
+"""/*
+|PothosDoc Array Forwarder (python)
+
+The Python array forwarder block forwards buffers
+from input port 0 to the output port 0 using workArrays().
+This block is mainly used for testing purposes.
+
+|category /Misc
+|keywords forwarder
+
+|param dtype[Data Type] The input and output data type.
+|default "float32"
+|widget StringEntry()
+
+|factory /python/array_forwarder(dtype)
+*/"""
+class ArrayForwarder(Pothos.Block):
+    def __init__(self, dtype):
+        Pothos.Block.__init__(self)
+        self.setupInput("0", dtype)
+        self.setupOutput("0", dtype)
+
+    def workArrays(self, inputs, outputs):
+        in0 = inputs[0]
+        out0 = outputs[0]
+        n = min(len(in0), len(out0))
+        out0[:n] = in0[:n]
+        return n, n
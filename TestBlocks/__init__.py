@@ -2,5 +2,6 @@
 # SPDX-License-Identifier: BSL-1.0
 
 from . Forwarder import Forwarder
+from . ArrayForwarder import ArrayForwarder
 from . SimpleSigSlots import SimpleSignalEmitter
 from . SimpleSigSlots import SimpleSlotAcceptor
@@ -1,21 +1,28 @@
-// Copyright (c) 2013-2020 Josh Blum
+// Copyright (c) 2013-2026 Josh Blum
 //                    2019 Nicholas Corgan
 // SPDX-License-Identifier: BSL-1.0
 
+#include "PythonProxy.hpp"
+#include "PythonExecutor.hpp"
 #include <Pothos/Testing.hpp>
 #include <Pothos/Proxy.hpp>
+#include <Pothos/Plugin.hpp>
 #include <Pothos/Framework/BufferChunk.hpp>
 #include <Poco/File.h>
 #include <Poco/Logger.h>
 #include <Poco/SimpleFileChannel.h>
 #include <Poco/TemporaryFile.h>
 #include <iostream>
+#include <chrono>
 #include <complex>
 #include <cstdlib>
 #include <fstream>
 #include <sstream>
 #include <complex>
 #include <limits>
+#include <atomic>
+#include <functional>
+#include <future>
 
 POTHOS_TEST_BLOCK("/proxy/python/tests", test_basic_types)
 {
@@ -86,6 +93,103 @@ POTHOS_TEST_BLOCK("/proxy/python/tests", test_type_bounds)
     testTypeBounds<double>(env);
 }
 
+POTHOS_TEST_BLOCK("/proxy/python/tests", test_convert_scalars_benchmark)
+{
+    auto env = Pothos::ProxyEnvironment::make("python");
+
+    //mixed scalar types that are converted by the registry
+    const Pothos::ProxyVector scalars{
+        env->makeProxy(true),
+        env->makeProxy(42),
+        env->makeProxy(1.5),
+        env->makeProxy(std::complex<double>(1, 2)),
+        env->makeProxy("hello"),
+    };
+
+    const size_t numIters = 1000000;
+    const auto t0 = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < numIters; i++)
+    {
+        env->convertProxyToObject(scalars[i % scalars.size()]);
+    }
+    const auto t1 = std::chrono::high_resolution_clock::now();
+
+    const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(t1-t0).count();
+    std::cout << "Proxy -> Object scalars: " << (elapsed/numIters) << " ns/conversion" << std::endl;
+}
+
+POTHOS_TEST_BLOCK("/proxy/python/tests", test_converter_cache_benchmark)
+{
+    auto env = Pothos::ProxyEnvironment::make("python");
+    auto numpy = env->findProxy("numpy");
+    auto builtins = env->findProxy((PY_MAJOR_VERSION >= 3)? "builtins" : "__builtin__");
+
+    //non-builtin types skip the scalar fast path and are looked up by class name,
+    //numpy types have registered converters, a plain object has none and stays a proxy
+    const Pothos::ProxyVector values{
+        numpy.call("zeros", 16, "float32"),
+        numpy.call("int16", 123),
+        builtins.call("object"),
+    };
+    POTHOS_TEST_TRUE(env->convertProxyToObject(values[0]).type() == typeid(Pothos::BufferChunk));
+    POTHOS_TEST_EQUAL(env->convertProxyToObject(values[1]).convert<short>(), 123);
+    POTHOS_TEST_TRUE(env->convertProxyToObject(values[2]).type() == typeid(Pothos::Proxy));
+
+    const size_t numIters = 10000;
+    auto timeIt = [numIters](const std::function<void(void)> &fcn)
+    {
+        const auto t0 = std::chrono::high_resolution_clock::now();
+        for (size_t i = 0; i < numIters; i++) fcn();
+        const auto t1 = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(t1-t0).count()/numIters;
+    };
+
+    //a converter plugin event invalidates the cache, so the next conversion searches the registry
+    const std::string dummyPath("/proxy/converters/python/test_converter_cache_dummy");
+    auto invalidate = [&dummyPath]
+    {
+        Pothos::PluginRegistry::add(dummyPath, Pothos::ProxyConvertPair("test_converter_cache_dummy", Pothos::Callable()));
+        Pothos::PluginRegistry::remove(dummyPath);
+    };
+
+    size_t i = 0;
+    const auto hit = timeIt([&]{env->convertProxyToObject(values[i++ % values.size()]);});
+    const auto events = timeIt(invalidate);
+    const auto miss = timeIt([&]{invalidate(); env->convertProxyToObject(values[i++ % values.size()]);});
+    std::cout << "Proxy -> Object cache hit: " << hit << " ns/conversion" << std::endl;
+    std::cout << "Proxy -> Object cache miss: " << (miss-events) << " ns/conversion" << std::endl;
+
+    //conversions are unchanged after the cache was rebuilt
+    POTHOS_TEST_TRUE(env->convertProxyToObject(values[0]).type() == typeid(Pothos::BufferChunk));
+    POTHOS_TEST_TRUE(env->convertProxyToObject(values[2]).type() == typeid(Pothos::Proxy));
+}
+
+POTHOS_TEST_BLOCK("/proxy/python/tests", test_scalar_fast_path_benchmark)
+{
+    auto env = Pothos::ProxyEnvironment::make("python");
+    auto pyFloat = env->makeProxy(1.5);
+
+    //the registered converters that the fast path bypasses
+    const auto toPyFloat = Pothos::PluginRegistry::get("/proxy/converters/python/double_to_pyfloat").getObject().extract<Pothos::Callable>();
+    const auto fromPyFloat = Pothos::PluginRegistry::get("/proxy/converters/python/pyfloat_to_double").getObject().extract<Pothos::ProxyConvertPair>().second;
+    POTHOS_TEST_EQUAL(toPyFloat.call<Pothos::Proxy>(env, 1.5).convert<double>(), 1.5);
+    POTHOS_TEST_EQUAL(fromPyFloat.call<double>(pyFloat), 1.5);
+
+    const size_t numIters = 100000;
+    auto timeIt = [numIters](const std::function<void(void)> &fcn)
+    {
+        const auto t0 = std::chrono::high_resolution_clock::now();
+        for (size_t i = 0; i < numIters; i++) fcn();
+        const auto t1 = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(t1-t0).count()/numIters;
+    };
+
+    std::cout << "double -> float registry: " << timeIt([&]{toPyFloat.call<Pothos::Proxy>(env, 1.5);}) << " ns" << std::endl;
+    std::cout << "double -> float fast path: " << timeIt([&]{env->makeProxy(1.5);}) << " ns" << std::endl;
+    std::cout << "float -> double registry: " << timeIt([&]{fromPyFloat.call<double>(pyFloat);}) << " ns" << std::endl;
+    std::cout << "float -> double fast path: " << timeIt([&]{env->convertProxyToObject(pyFloat);}) << " ns" << std::endl;
+}
+
 POTHOS_TEST_BLOCK("/proxy/python/tests", test_compare_to)
 {
     auto env = Pothos::ProxyEnvironment::make("python");
@@ -109,7 +213,118 @@ POTHOS_TEST_BLOCK("/proxy/python/tests", test_compare_to)
     auto int2Again = env->makeProxy(2);
     POTHOS_TEST_EQUAL(int2.compareTo(int2), 0);
     POTHOS_TEST_EQUAL(int2.compareTo(int2Again), 0);
+
+    //same-typed floats and strings, mixed numeric types
+    POTHOS_TEST_TRUE(env->makeProxy(-1.5) < env->makeProxy(2.5));
+    POTHOS_TEST_TRUE(env->makeProxy("abc") < env->makeProxy("abd"));
+    POTHOS_TEST_EQUAL(env->makeProxy("xyz").compareTo(env->makeProxy("xyz")), 0);
+    POTHOS_TEST_TRUE(int1 < env->makeProxy(1.5));
+    POTHOS_TEST_EQUAL(int1.compareTo(env->makeProxy(1.0)), 0);
+
+    //sets convert in sorted order
+    auto builtins = env->findProxy((PY_MAJOR_VERSION >= 3)? "builtins" : "__builtin__");
+    auto pySet = builtins.call("set", builtins.call("range", 100));
+    const auto proxySet = pySet.convert<Pothos::ProxySet>();
+    POTHOS_TEST_EQUAL(proxySet.size(), 100);
+    POTHOS_TEST_EQUAL(proxySet.begin()->convert<int>(), 0);
+    POTHOS_TEST_EQUAL(proxySet.rbegin()->convert<int>(), 99);
+
+    //distinct NaN keys stay distinct and sort after numbers
+    auto nan0 = builtins.call("float", "nan");
+    auto nan1 = builtins.call("float", "nan");
+    POTHOS_TEST_EQUAL(nan0.compareTo(nan0), 0);
+    POTHOS_TEST_TRUE(nan0.compareTo(nan1) != 0);
+    POTHOS_TEST_EQUAL(nan0.compareTo(nan1), -nan1.compareTo(nan0));
+    POTHOS_TEST_TRUE(env->makeProxy(1.5) < nan0);
+    POTHOS_TEST_TRUE(int1 < nan0);
+    auto nanSet = builtins.call("set", env->makeProxy(Pothos::ProxyVector{nan0, nan1, env->makeProxy(1.0)}));
+    POTHOS_TEST_EQUAL(nanSet.convert<Pothos::ProxySet>().size(), 3);
+}
+
+#if PY_VERSION_HEX >= 0x03050000
+/***********************************************************************
+ * Count python heap allocations by hooking the allocator domains,
+ * C++ allocations such as the result proxy handle are not counted
+ **********************************************************************/
+static std::atomic<size_t> numPyAllocs(0);
+static PyMemAllocatorEx origMemAllocator, origObjAllocator;
+
+static void *countingMalloc(void *ctx, size_t size)
+{
+    numPyAllocs++;
+    auto alloc = reinterpret_cast<PyMemAllocatorEx *>(ctx);
+    return alloc->malloc(alloc->ctx, size);
+}
+
+static void *countingCalloc(void *ctx, size_t nelem, size_t elsize)
+{
+    numPyAllocs++;
+    auto alloc = reinterpret_cast<PyMemAllocatorEx *>(ctx);
+    return alloc->calloc(alloc->ctx, nelem, elsize);
+}
+
+static void *countingRealloc(void *ctx, void *ptr, size_t size)
+{
+    numPyAllocs++;
+    auto alloc = reinterpret_cast<PyMemAllocatorEx *>(ctx);
+    return alloc->realloc(alloc->ctx, ptr, size);
+}
+
+static void countingFree(void *ctx, void *ptr)
+{
+    auto alloc = reinterpret_cast<PyMemAllocatorEx *>(ctx);
+    alloc->free(alloc->ctx, ptr);
+}
+
+static void setCountingAllocators(const bool enable)
+{
+    if (enable)
+    {
+        PyMem_GetAllocator(PYMEM_DOMAIN_MEM, &origMemAllocator);
+        PyMem_GetAllocator(PYMEM_DOMAIN_OBJ, &origObjAllocator);
+        PyMemAllocatorEx memHook = {&origMemAllocator, countingMalloc, countingCalloc, countingRealloc, countingFree};
+        PyMemAllocatorEx objHook = {&origObjAllocator, countingMalloc, countingCalloc, countingRealloc, countingFree};
+        PyMem_SetAllocator(PYMEM_DOMAIN_MEM, &memHook);
+        PyMem_SetAllocator(PYMEM_DOMAIN_OBJ, &objHook);
+    }
+    else
+    {
+        PyMem_SetAllocator(PYMEM_DOMAIN_MEM, &origMemAllocator);
+        PyMem_SetAllocator(PYMEM_DOMAIN_OBJ, &origObjAllocator);
+    }
+}
+
+POTHOS_TEST_BLOCK("/proxy/python/tests", test_call_allocations)
+{
+    auto env = Pothos::ProxyEnvironment::make("python");
+
+    //a call whose result is a cached small integer
+    Pothos::ProxyVector testVec(3, env->makeProxy(0));
+    auto list = env->makeProxy(testVec);
+    auto zero = env->makeProxy(0);
+    POTHOS_TEST_EQUAL(list.call<int>("count", zero), 3);
+
+    //hold the GIL so the thread state persists across calls
+    const size_t numIters = 1000;
+    {
+        PyGilStateLock lock;
+        numPyAllocs = 0;
+        setCountingAllocators(true);
+        for (size_t i = 0; i < numIters; i++) list.call("count", zero);
+        setCountingAllocators(false);
+    }
+
+    //methods are called without a bound method object on python 3.9 and later,
+    //only python heap allocations are counted, the C++ proxy handles are not
+    const double allocsPerCall = double(numPyAllocs)/numIters;
+    std::cout << "Python heap allocations per call: " << allocsPerCall << std::endl;
+    #if PY_VERSION_HEX >= 0x03090000
+    POTHOS_TEST_TRUE(allocsPerCall < 1.0);
+    #else
+    POTHOS_TEST_TRUE(allocsPerCall < 2.0);
+    #endif
 }
+#endif
 
 POTHOS_TEST_BLOCK("/proxy/python/tests", test_containers)
 {
@@ -162,6 +377,68 @@ POTHOS_TEST_BLOCK("/proxy/python/tests", test_containers)
     auto find1 = resultDict.find(env->makeProxy(1));
     POTHOS_TEST_TRUE(find1 != resultDict.end());
     POTHOS_TEST_EQUAL(find1->second.convert<int>(), 2);
+
+    //benchmark a large configuration dictionary
+    const size_t numEntries = 1000000;
+    auto builtins = env->findProxy((PY_MAJOR_VERSION >= 3)? "builtins" : "__builtin__");
+    auto keys = builtins.call("map", builtins.get("str"), builtins.call("range", numEntries));
+    auto largeDict = builtins.call("dict", builtins.call("zip", keys, builtins.call("range", numEntries)));
+
+    const auto t0 = std::chrono::high_resolution_clock::now();
+    const auto largeMap = largeDict.convert<Pothos::ProxyMap>();
+    const auto t1 = std::chrono::high_resolution_clock::now();
+    const auto largeDictOut = env->makeProxy(largeMap);
+    const auto t2 = std::chrono::high_resolution_clock::now();
+
+    POTHOS_TEST_EQUAL(largeMap.size(), numEntries);
+    POTHOS_TEST_EQUAL(largeDictOut.call<size_t>("__len__"), numEntries);
+    std::cout << "dict[1M] -> ProxyMap: " << std::chrono::duration_cast<std::chrono::milliseconds>(t1-t0).count() << " ms" << std::endl;
+    std::cout << "ProxyMap[1M] -> dict: " << std::chrono::duration_cast<std::chrono::milliseconds>(t2-t1).count() << " ms" << std::endl;
+}
+
+POTHOS_TEST_BLOCK("/proxy/python/tests", test_homogeneous_sequences)
+{
+    auto env = Pothos::ProxyEnvironment::make("python");
+    auto builtins = env->findProxy((PY_MAJOR_VERSION >= 3)? "builtins" : "__builtin__");
+
+    //float lists convert into any numeric vector type
+    const std::vector<double> taps{0.5, -0.25, 0.125, 1.0};
+    auto pyTaps = env->makeProxy(taps);
+    POTHOS_TEST_EQUALV(pyTaps.convert<std::vector<double>>(), taps);
+    POTHOS_TEST_EQUALV(pyTaps.convert<std::vector<float>>(), std::vector<float>(taps.begin(), taps.end()));
+
+    //integer tuples and complex lists
+    const std::vector<int> ints{-1, 0, 42};
+    auto pyInts = builtins.call("tuple", env->makeProxy(ints));
+    POTHOS_TEST_EQUALV(pyInts.convert<std::vector<int>>(), ints);
+    const std::vector<std::complex<double>> complexes{{1.0, 2.0}, {-3.0, 0.5}};
+    POTHOS_TEST_EQUALV(env->makeProxy(complexes).convert<std::vector<std::complex<double>>>(), complexes);
+
+    //proxy vectors are made on request and the result converts back into a list
+    const auto proxyVec = pyTaps.convert<Pothos::ProxyVector>();
+    POTHOS_TEST_EQUAL(proxyVec.size(), taps.size());
+    POTHOS_TEST_EQUAL(proxyVec[1].convert<double>(), taps[1]);
+    POTHOS_TEST_EQUAL(pyInts.convert<Pothos::ProxyVector>().size(), ints.size());
+    POTHOS_TEST_EQUAL(env->convertObjectToProxy(pyTaps.toObject()).getClassName(), "list");
+
+    //the result is a snapshot of the list
+    const auto tapsObj = pyTaps.toObject();
+    pyTaps.call("append", 2.0);
+    POTHOS_TEST_EQUALV(tapsObj.convert<std::vector<double>>(), taps);
+
+    //mixed sequences convert element by element
+    Pothos::ProxyVector mixed{env->makeProxy(1), env->makeProxy(2.5), env->makeProxy(true)};
+    const std::vector<double> mixedOut{1.0, 2.5, 1.0};
+    POTHOS_TEST_EQUALV(env->makeProxy(mixed).convert<std::vector<double>>(), mixedOut);
+
+    //time a large retuning list
+    const std::vector<double> manyTaps(4096, 0.5);
+    auto pyManyTaps = env->makeProxy(manyTaps);
+    const auto t0 = std::chrono::high_resolution_clock::now();
+    const auto result = pyManyTaps.convert<std::vector<float>>();
+    const auto t1 = std::chrono::high_resolution_clock::now();
+    POTHOS_TEST_EQUAL(result.size(), manyTaps.size());
+    std::cout << "list[4096] -> vector<float>: " << std::chrono::duration_cast<std::chrono::microseconds>(t1-t0).count() << " us" << std::endl;
 }
 
 POTHOS_TEST_BLOCK("/proxy/python/tests", test_call_module)
@@ -183,6 +460,134 @@ POTHOS_TEST_BLOCK("/proxy/python/tests", test_call_module)
     POTHOS_TEST_EQUAL(datetime2000.get<int>("year"), 2000);
 }
 
+POTHOS_TEST_BLOCK("/proxy/python/tests", test_call_async)
+{
+    auto env = Pothos::ProxyEnvironment::make("python");
+    auto pyEnv = std::dynamic_pointer_cast<PythonProxyEnvironment>(env);
+    auto builtins = env->findProxy((PY_MAJOR_VERSION >= 3)? "builtins" : "__builtin__");
+
+    //queued calls complete in order on the environment's python thread,
+    //arguments are objects and are converted into python on that thread
+    std::vector<std::future<Pothos::Object>> futures;
+    for (int i = 0; i < 100; i++)
+    {
+        const Pothos::Object arg(-i);
+        futures.push_back(pyEnv->callAsync(builtins, "abs", &arg, 1));
+    }
+    for (int i = 0; i < 100; i++)
+    {
+        POTHOS_TEST_EQUAL(futures[i].get().convert<int>(), i);
+    }
+
+    //python errors are delivered through the future
+    const Pothos::Object badArg(std::string("oops"));
+    auto error = pyEnv->callAsync(builtins, "abs", &badArg, 1);
+    POTHOS_TEST_THROWS(error.get(), Pothos::ProxyExceptionMessage);
+
+    //the registry helper exposes the same call outside this module
+    const auto callAsync = Pothos::PluginRegistry::get("/proxy_helpers/python/call_async").getObject().extract<Pothos::Callable>();
+    const std::vector<Pothos::Object> args(1, Pothos::Object(-42));
+    auto result = callAsync.call<std::shared_future<Pothos::Object>>(builtins, "abs", args);
+    POTHOS_TEST_EQUAL(result.get().convert<int>(), 42);
+}
+
+POTHOS_TEST_BLOCK("/proxy/python/tests", test_gil_acquisitions)
+{
+    auto env = Pothos::ProxyEnvironment::make("python");
+    const auto toProxy = Pothos::PluginRegistry::get("/proxy_helpers/python/pyobject_to_proxy").getObject().extract<PyObjectToProxyFcn>();
+
+    PyGilStateLock lock;
+    PyObjectRef obj(PyLong_FromLong(42), REF_NEW);
+    const size_t numIters = 1000;
+
+    //the module converts with the caller's GIL, the handle re-enters it
+    auto before = pyGilAcquisitions().load();
+    for (size_t i = 0; i < numIters; i++) toProxy(env, obj.obj);
+    const auto keptGil = pyGilAcquisitions().load() - before;
+
+    //the previous module code released the GIL around each conversion
+    before = pyGilAcquisitions().load();
+    for (size_t i = 0; i < numIters; i++)
+    {
+        Pothos::Proxy proxy;
+        {
+            PyThreadStateLock unlock;
+            proxy = toProxy(env, obj.obj);
+        }
+    }
+    const auto handedOff = pyGilAcquisitions().load() - before;
+
+    std::cout << "GIL acquisitions per conversion: " << double(keptGil)/numIters
+        << " (released: " << double(handedOff)/numIters << ")" << std::endl;
+    POTHOS_TEST_EQUAL(keptGil, 0);
+    POTHOS_TEST_TRUE(handedOff >= numIters);
+}
+
+POTHOS_TEST_BLOCK("/proxy/python/tests", test_executor_threads_arg)
+{
+    Pothos::ProxyEnvironmentArgs args;
+    args["executor"] = "dedicated";
+    for (const std::string threads : {"0", "many", "99999999999999999999999"})
+    {
+        args["executor_threads"] = threads;
+        POTHOS_TEST_THROWS(Pothos::ProxyEnvironment::make("python", args), Pothos::ProxyEnvironmentFactoryError);
+    }
+}
+
+POTHOS_TEST_BLOCK("/proxy/python/tests", test_executor_pools)
+{
+    //callers with the same thread count are assigned round-robin within one pool
+    auto single0 = PythonExecutor::get(1);
+    auto single1 = PythonExecutor::get(1);
+    POTHOS_TEST_TRUE(single0 == single1);
+
+    //a different thread count has its own pool and counter
+    auto pair0 = PythonExecutor::get(2);
+    auto pair1 = PythonExecutor::get(2);
+    auto pair2 = PythonExecutor::get(2);
+    POTHOS_TEST_TRUE(pair0 != pair1);
+    POTHOS_TEST_TRUE(pair0 == pair2);
+    POTHOS_TEST_TRUE(pair0 != single0 and pair1 != single0);
+    POTHOS_TEST_TRUE(PythonExecutor::get(1) == single0);
+}
+
+POTHOS_TEST_BLOCK("/proxy/python/tests", test_byte_vectors)
+{
+    const std::vector<char> packet{'\x7e', '\x00', '\x42', '\xff'};
+
+    //memoryview mode references the vector read-only
+    Pothos::ProxyEnvironmentArgs args;
+    args["byte_vectors"] = "memoryview";
+    auto env = Pothos::ProxyEnvironment::make("python", args);
+    auto view = env->makeProxy(packet);
+    POTHOS_TEST_EQUAL(view.getClassName(), "memoryview");
+    POTHOS_TEST_TRUE(view.get<bool>("readonly"));
+    POTHOS_TEST_EQUALV(view.convert<std::vector<char>>(), packet);
+
+    //the view shares the storage of the converted object
+    Pothos::Object packetObj(packet);
+    auto packetView = env->convertObjectToProxy(packetObj);
+    auto viewArray = env->findProxy("numpy").call("frombuffer", packetView, "uint8");
+    POTHOS_TEST_EQUAL(viewArray.get("ctypes").get<size_t>("data"), size_t(packetObj.extract<std::vector<char>>().data()));
+
+    //the default is a bytes copy
+    auto defaultEnv = Pothos::ProxyEnvironment::make("python");
+    auto bytes = defaultEnv->makeProxy(packet);
+    POTHOS_TEST_EQUAL(bytes.getClassName(), "bytes");
+
+    //bytearray and buffer objects convert without an intermediate bytes
+    auto builtins = defaultEnv->findProxy((PY_MAJOR_VERSION >= 3)? "builtins" : "__builtin__");
+    POTHOS_TEST_EQUALV(builtins.call("bytearray", bytes).convert<std::vector<char>>(), packet);
+    POTHOS_TEST_EQUALV(builtins.call("memoryview", bytes).convert<std::vector<char>>(), packet);
+    POTHOS_TEST_EQUALV(defaultEnv->findProxy("array").call("array", "B", bytes).convert<std::vector<char>>(), packet);
+    auto ubyteArray = defaultEnv->findProxy("ctypes").get("c_ubyte").call("__mul__", packet.size());
+    POTHOS_TEST_EQUALV(ubyteArray.call("from_buffer_copy", bytes).convert<std::vector<char>>(), packet);
+
+    //buffers of wider elements are not byte vectors
+    auto intView = builtins.call("memoryview", bytes).call("cast", "i");
+    POTHOS_TEST_THROWS(intView.convert<std::vector<char>>(), Pothos::Exception);
+}
+
 POTHOS_TEST_BLOCK("/proxy/python/tests", test_serialization)
 {
     auto env = Pothos::ProxyEnvironment::make("python");
@@ -231,6 +636,108 @@ POTHOS_TEST_BLOCK("/proxy/python/tests", test_numpy_array)
     POTHOS_TEST_EQUAL(buffIn.elements(), buffOut.elements());
     POTHOS_TEST_EQUAL(buffIn.dtype, buffOut.dtype);
     POTHOS_TEST_EQUALA(buffIn.as<const float *>(), buffOut.as<const float *>(), buffOut.elements());
+
+    //complex integers have no numpy type, real and imag are the last dimension
+    Pothos::BufferChunk buffComplex(Pothos::DType("complex_int16"), 10);
+    const auto shape = env->makeProxy(buffComplex).get<Pothos::ProxyVector>("shape");
+    POTHOS_TEST_EQUAL(shape.size(), 2);
+    POTHOS_TEST_EQUAL(shape[0].convert<size_t>(), 10);
+    POTHOS_TEST_EQUAL(shape[1].convert<size_t>(), 2);
+
+    //strided arrays are copied into a contiguous buffer
+    auto numpy = env->findProxy("numpy");
+    auto transposed = numpy.call("arange", 0, 12, 1, "int32").call("reshape", 3, 4).get("T");
+    const auto buffStrided = transposed.convert<Pothos::BufferChunk>();
+    POTHOS_TEST_EQUAL(buffStrided.elements(), 4);
+    POTHOS_TEST_EQUAL(buffStrided.dtype, Pothos::DType("int32", 3));
+    const std::vector<int> expected{0, 4, 8, 1, 5, 9, 2, 6, 10, 3, 7, 11};
+    POTHOS_TEST_EQUALA(buffStrided.as<const int *>(), expected.data(), expected.size());
+}
+
+POTHOS_TEST_BLOCK("/proxy/python/tests", test_numpy_array_latency)
+{
+    auto env = Pothos::ProxyEnvironment::make("python");
+    Pothos::BufferChunk buffIn(typeid(float), 64);
+    const size_t numIters = 10000;
+
+    const auto t0 = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < numIters; i++) env->makeProxy(buffIn);
+    const auto t1 = std::chrono::high_resolution_clock::now();
+
+    auto pyBuff = env->makeProxy(buffIn);
+    const auto t2 = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < numIters; i++) pyBuff.convert<Pothos::BufferChunk>();
+    const auto t3 = std::chrono::high_resolution_clock::now();
+
+    const auto toNumpy = std::chrono::duration_cast<std::chrono::nanoseconds>(t1-t0).count()/numIters;
+    const auto fromNumpy = std::chrono::duration_cast<std::chrono::nanoseconds>(t3-t2).count()/numIters;
+    std::cout << "BufferChunk -> ndarray: " << toNumpy << " ns/call" << std::endl;
+    std::cout << "ndarray -> BufferChunk: " << fromNumpy << " ns/call" << std::endl;
+}
+
+POTHOS_TEST_BLOCK("/proxy/python/tests", test_numeric_vectors_as_arrays)
+{
+    Pothos::ProxyEnvironmentArgs args;
+    args["numeric_vectors"] = "ndarray";
+    auto env = Pothos::ProxyEnvironment::make("python", args);
+
+    //vectors are copied into the array
+    const std::vector<float> vecFloat{1.0f, 2.0f, 3.0f};
+    auto pyFloat = env->makeProxy(vecFloat);
+    POTHOS_TEST_EQUAL(pyFloat.getClassName(), "numpy.ndarray");
+    POTHOS_TEST_EQUAL(pyFloat.get("dtype").get<std::string>("name"), "float32");
+    const auto buffFloat = pyFloat.convert<Pothos::BufferChunk>();
+    POTHOS_TEST_EQUAL(buffFloat.elements(), vecFloat.size());
+    POTHOS_TEST_EQUALA(buffFloat.as<const float *>(), vecFloat.data(), vecFloat.size());
+
+    //complex vectors keep their element type
+    auto pyComplex = env->convertObjectToProxy(Pothos::Object(std::vector<std::complex<double>>(10, std::complex<double>(1.0, -1.0))));
+    POTHOS_TEST_EQUAL(pyComplex.getClassName(), "numpy.ndarray");
+    POTHOS_TEST_EQUAL(pyComplex.get("dtype").get<std::string>("name"), "complex128");
+    POTHOS_TEST_EQUAL(pyComplex.call<size_t>("__len__"), 10);
+
+    //the default environment still converts into a list
+    auto pyList = Pothos::ProxyEnvironment::make("python")->makeProxy(vecFloat);
+    POTHOS_TEST_EQUAL(pyList.getClassName(), "list");
+}
+
+template <typename T>
+void testBufferToVector(Pothos::ProxyEnvironment::Sptr env, const std::string &arrayCode)
+{
+    const std::vector<T> bounds{std::numeric_limits<T>::min(), T(0), std::numeric_limits<T>::max()};
+    Pothos::ProxyVector elems;
+    for (const auto &num : bounds) elems.push_back(env->makeProxy(num));
+    const auto list = env->makeProxy(elems);
+    const auto dtypeName = Pothos::DType(typeid(T)).name();
+
+    const auto npArray = env->findProxy("numpy").call("array", list, dtypeName);
+    POTHOS_TEST_EQUALV(npArray.template convert<std::vector<T>>(), bounds);
+
+    const auto pyArray = env->findProxy("array").call("array", arrayCode, list);
+    POTHOS_TEST_EQUALV(pyArray.template convert<std::vector<T>>(), bounds);
+}
+
+POTHOS_TEST_BLOCK("/proxy/python/tests", test_buffer_to_vector)
+{
+    auto env = Pothos::ProxyEnvironment::make("python");
+
+    testBufferToVector<std::int8_t>(env, "b");
+    testBufferToVector<std::int16_t>(env, "h");
+    testBufferToVector<std::int32_t>(env, "i");
+    testBufferToVector<std::int64_t>(env, "q");
+    testBufferToVector<std::uint8_t>(env, "B");
+    testBufferToVector<std::uint16_t>(env, "H");
+    testBufferToVector<std::uint32_t>(env, "I");
+    testBufferToVector<std::uint64_t>(env, "Q");
+    testBufferToVector<float>(env, "f");
+    testBufferToVector<double>(env, "d");
+
+    //complex arrays and element type conversion
+    auto numpy = env->findProxy("numpy");
+    const std::vector<std::complex<float>> taps{{1.0f, -1.0f}, {0.5f, 0.25f}};
+    POTHOS_TEST_EQUALV(numpy.call("array", env->makeProxy(taps), "complex64").convert<std::vector<std::complex<float>>>(), taps);
+    const std::vector<float> widened{-3.0f, 0.0f, 7.0f};
+    POTHOS_TEST_EQUALV(numpy.call("array", env->makeProxy(widened), "int16").convert<std::vector<float>>(), widened);
 }
 
 POTHOS_TEST_BLOCK("/proxy/python/tests", test_numpy_types)
@@ -1,11 +1,18 @@
-// Copyright (c) 2014-2017 Josh Blum
+// Copyright (c) 2014-2026 Josh Blum
 // SPDX-License-Identifier: BSL-1.0
 
 #include <Pothos/Framework.hpp>
 #include <Pothos/Managed.hpp>
 #include <Pothos/Testing.hpp>
 #include <Pothos/Proxy.hpp>
+#include <Pothos/Plugin.hpp>
+#include <Poco/Path.h>
 #include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <map>
 #include <json.hpp>
 
 using json = nlohmann::json;
@@ -49,6 +56,217 @@ POTHOS_TEST_BLOCK("/proxy/python/tests", test_python_block)
     std::cout << "run done\n";
 }
 
+POTHOS_TEST_BLOCK("/proxy/python/tests", test_python_block_work_arrays)
+{
+    auto feeder = Pothos::BlockRegistry::make("/blocks/feeder_source", "int");
+    auto collector = Pothos::BlockRegistry::make("/blocks/collector_sink", "int");
+    auto forwarder = Pothos::BlockRegistry::make("/python/array_forwarder", Pothos::DType("int"));
+
+    json testPlan;
+    testPlan["enableBuffers"] = true;
+    auto expected = feeder.call("feedTestPlan", testPlan.dump());
+
+    {
+        Pothos::Topology topology;
+        topology.connect(feeder, 0, forwarder, 0);
+        topology.connect(forwarder, 0, collector, 0);
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive(0.5, 5.0));
+    }
+
+    collector.call("verifyTestPlan", expected);
+}
+
+POTHOS_TEST_BLOCK("/proxy/python/tests", test_python_block_scaling)
+{
+    //independent forwarders only scale when the interpreter is free-threaded
+    const size_t numElems = 1 << 20;
+    Pothos::BufferChunk buffer(typeid(int), numElems);
+    const size_t maxChains = std::max<size_t>(1, std::min<size_t>(8, std::thread::hardware_concurrency()));
+
+    for (size_t numChains = 1; numChains <= maxChains; numChains *= 2)
+    {
+        std::vector<Pothos::Proxy> collectors;
+        Pothos::Topology topology;
+        for (size_t i = 0; i < numChains; i++)
+        {
+            auto feeder = Pothos::BlockRegistry::make("/blocks/feeder_source", "int");
+            auto forwarder = Pothos::BlockRegistry::make("/python/forwarder", Pothos::DType("int"));
+            auto collector = Pothos::BlockRegistry::make("/blocks/collector_sink", "int");
+            feeder.call("feedBuffer", buffer);
+            topology.connect(feeder, 0, forwarder, 0);
+            topology.connect(forwarder, 0, collector, 0);
+            collectors.push_back(collector);
+        }
+
+        const auto t0 = std::chrono::high_resolution_clock::now();
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive(0.5, 60.0));
+        const auto t1 = std::chrono::high_resolution_clock::now();
+
+        for (const auto &collector : collectors)
+        {
+            POTHOS_TEST_EQUAL(collector.call<Pothos::BufferChunk>("getBuffer").elements(), numElems);
+        }
+        const double seconds = std::chrono::duration<double>(t1-t0).count();
+        const double rate = (numChains*numElems)/seconds;
+        std::cout << numChains << " python forwarders: " << rate/1e6 << " Melem/s total, "
+            << rate/numChains/1e6 << " Melem/s per core" << std::endl;
+    }
+}
+
+POTHOS_TEST_BLOCK("/proxy/python/tests", test_python_block_min_work_elements)
+{
+    auto feeder = Pothos::BlockRegistry::make("/blocks/feeder_source", "int");
+    auto collector = Pothos::BlockRegistry::make("/blocks/collector_sink", "int");
+    auto forwarder = Pothos::BlockRegistry::make("/python/forwarder", Pothos::DType("int"));
+    forwarder.set("minWorkElements", size_t(1024));
+    POTHOS_TEST_EQUAL(forwarder.get<size_t>("minWorkElements"), 1024);
+
+    //small buffers are batched, and the tail drains after the flush timeout
+    json testPlan;
+    testPlan["enableBuffers"] = true;
+    auto expected = feeder.call("feedTestPlan", testPlan.dump());
+
+    {
+        Pothos::Topology topology;
+        topology.connect(feeder, 0, forwarder, 0);
+        topology.connect(forwarder, 0, collector, 0);
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive(0.5, 5.0));
+    }
+
+    collector.call("verifyTestPlan", expected);
+
+    //input that arrives in stages is held until the flush timeout
+    feeder = Pothos::BlockRegistry::make("/blocks/feeder_source", "int");
+    collector = Pothos::BlockRegistry::make("/blocks/collector_sink", "int");
+    forwarder = Pothos::BlockRegistry::make("/python/forwarder", Pothos::DType("int"));
+    forwarder.set("minWorkElements", size_t(1024));
+    forwarder.call("setWorkFlushTimeout", 0.2);
+    Pothos::BufferChunk buffer(typeid(int), 100);
+    feeder.call("feedBuffer", buffer);
+    {
+        Pothos::Topology topology;
+        topology.connect(feeder, 0, forwarder, 0);
+        topology.connect(forwarder, 0, collector, 0);
+        topology.commit();
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        feeder.call("feedBuffer", buffer);
+        POTHOS_TEST_TRUE(topology.waitInactive(0.5, 5.0));
+    }
+    POTHOS_TEST_EQUAL(collector.call<Pothos::BufferChunk>("getBuffer").elements(), 2*buffer.elements());
+    const auto avoided = forwarder.call<unsigned long long>("getAvoidedWorkCalls");
+    std::cout << "avoided work calls: " << avoided << std::endl;
+    POTHOS_TEST_TRUE(avoided > 0);
+}
+
+POTHOS_TEST_BLOCK("/proxy/python/tests", test_python_block_executor)
+{
+    //forwarders share one dedicated executor rather than trading the GIL
+    const size_t numElems = 1 << 20;
+    const size_t numChains = 4;
+    Pothos::BufferChunk buffer(typeid(int), numElems);
+
+    std::vector<Pothos::Proxy> forwarders, collectors;
+    Pothos::Topology topology;
+    for (size_t i = 0; i < numChains; i++)
+    {
+        auto feeder = Pothos::BlockRegistry::make("/blocks/feeder_source", "int");
+        auto forwarder = Pothos::BlockRegistry::make("/python/forwarder", Pothos::DType("int"));
+        auto collector = Pothos::BlockRegistry::make("/blocks/collector_sink", "int");
+        forwarder.call("setPythonExecutor", size_t(1));
+        feeder.call("feedBuffer", buffer);
+        topology.connect(feeder, 0, forwarder, 0);
+        topology.connect(forwarder, 0, collector, 0);
+        forwarders.push_back(forwarder);
+        collectors.push_back(collector);
+    }
+
+    const auto t0 = std::chrono::high_resolution_clock::now();
+    topology.commit();
+    POTHOS_TEST_TRUE(topology.waitInactive(0.5, 60.0));
+    const auto t1 = std::chrono::high_resolution_clock::now();
+
+    for (const auto &collector : collectors)
+    {
+        POTHOS_TEST_EQUAL(collector.call<Pothos::BufferChunk>("getBuffer").elements(), numElems);
+    }
+    const auto stats = forwarders.front().call<Pothos::ObjectKwargs>("getPythonExecutorStats");
+    POTHOS_TEST_TRUE(stats.at("totalCalls").convert<unsigned long long>() > 0);
+    const double seconds = std::chrono::duration<double>(t1-t0).count();
+    std::cout << numChains << " python forwarders on one executor: "
+        << (numChains*numElems)/seconds/1e6 << " Melem/s total, "
+        << stats.at("meanLatencyUs").convert<double>() << " us mean queue latency" << std::endl;
+}
+
+POTHOS_TEST_BLOCK("/proxy/python/tests", test_conf_loader_child_process)
+{
+    auto loader = Pothos::PluginRegistry::get("/framework/conf_loader/python").getObject().extract<Pothos::Callable>();
+    std::map<std::string, std::string> config;
+    config["confFilePath"] = Poco::Path(Poco::Path::temp(), "PothosTestChildProcess.conf").toString();
+    config["doc_sources"] = "";
+    config["factories"] = "/python/tests/child_forwarder:PothosTestBlocks.Forwarder";
+
+    //only local and child are valid process values
+    config["process"] = "thread";
+    POTHOS_TEST_THROWS(loader.call<std::vector<Pothos::PluginPath>>(config), Pothos::Exception);
+
+    config["process"] = "child";
+    const auto entries = loader.call<std::vector<Pothos::PluginPath>>(config);
+    std::weak_ptr<Pothos::ProxyEnvironment> childEnv;
+    {
+        auto feeder = Pothos::BlockRegistry::make("/blocks/feeder_source", "int");
+        auto collector = Pothos::BlockRegistry::make("/blocks/collector_sink", "int");
+        auto forwarder = Pothos::BlockRegistry::make("/python/tests/child_forwarder", Pothos::DType("int"));
+        childEnv = forwarder.getEnvironment();
+        POTHOS_TEST_TRUE(forwarder.getEnvironment()->getUniquePid() != Pothos::ProxyEnvironment::getLocalUniquePid());
+
+        json testPlan;
+        testPlan["enableBuffers"] = true;
+        testPlan["enableLabels"] = true;
+        testPlan["enableMessages"] = true;
+        auto expected = feeder.call("feedTestPlan", testPlan.dump());
+        {
+            Pothos::Topology topology;
+            topology.connect(feeder, 0, forwarder, 0);
+            topology.connect(forwarder, 0, collector, 0);
+            topology.commit();
+            POTHOS_TEST_TRUE(topology.waitInactive(0.5, 10.0));
+        }
+        collector.call("verifyTestPlan", expected);
+    }
+
+    //the child process host is released with the block
+    POTHOS_TEST_TRUE(childEnv.expired());
+    for (const auto &entry : entries) Pothos::PluginRegistry::remove(entry);
+}
+
+POTHOS_TEST_BLOCK("/proxy/python/tests", test_conf_loader_environment)
+{
+    auto loader = Pothos::PluginRegistry::get("/framework/conf_loader/python").getObject().extract<Pothos::Callable>();
+    std::map<std::string, std::string> config;
+    config["confFilePath"] = Poco::Path(Poco::Path::temp(), "PothosTestEnvironment.conf").toString();
+    config["doc_sources"] = "";
+    config["factories"] = "/python/tests/env_forwarder:PothosTestBlocks.Forwarder";
+
+    //entries must be key=value
+    config["environment"] = "numeric_vectors";
+    POTHOS_TEST_THROWS(loader.call<std::vector<Pothos::PluginPath>>(config), Pothos::Exception);
+
+    //the block's environment is created with the entries as args
+    config["environment"] = "numeric_vectors=ndarray byte_vectors=memoryview";
+    const auto entries = loader.call<std::vector<Pothos::PluginPath>>(config);
+    {
+        auto forwarder = Pothos::BlockRegistry::make("/python/tests/env_forwarder", Pothos::DType("int"));
+        auto env = forwarder.getEnvironment();
+        POTHOS_TEST_EQUAL(env->getName(), "python");
+        POTHOS_TEST_EQUAL(env->makeProxy(std::vector<int>{1, 2, 3}).getClassName(), "numpy.ndarray");
+        POTHOS_TEST_EQUAL(env->makeProxy(std::vector<char>{'a', 'b'}).getClassName(), "memoryview");
+    }
+    for (const auto &entry : entries) Pothos::PluginRegistry::remove(entry);
+}
+
 POTHOS_TEST_BLOCK("/proxy/python/tests", test_signals_and_slots)
 {
     auto env = Pothos::ProxyEnvironment::make("managed");